@@ -1,62 +1,58 @@
 #include "Algorithms.h"
 
 
-// Function to test the given vertex 'w' and visit it if conditions are met
-void testAndVisit(std::queue< Vertex*> &q, Edge *e, Vertex *w, double residual) {
-    // Check if the vertex 'w' is not visited and there is residual capacity
-    if (! w->isVisited() && residual > 0) {
-        // Mark 'w' as visited, set the path through which it was reached, and enqueue it
-        w->setVisited(true);
-        w->setPath(e);
-        q.push(w);
-    }
-}
-
 // Function to find an augmenting path using Breadth-First Search
-bool findAugmentingPath(Graph *g, Vertex *s, Vertex *t) {
+bool findAugmentingPath(ResidualGraph &rg, vector<int> &path, vector<char> &visited, vector<uint32_t> &q) {
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<double> &capacities = rg.getArcCapacities();
+    const vector<double> &flows = rg.getArcFlows();
+    const vector<char> &activeVertices = rg.getActiveVertices();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+    uint32_t s = rg.getSource();
+    uint32_t t = rg.getTarget();
+
     // Mark all vertices as not visited
-    for(auto v : g->getVertexSet()) {
-        v.second->setVisited(false);
-    }
+    std::fill(visited.begin(), visited.end(), 0);
 
     // Mark the source vertex as visited and enqueue it
-    s->setVisited(true);
-    std::queue<Vertex *> q;
-    q.push(s);
+    visited[s] = 1;
+    int head = 0, tail = 0;
+    q[tail++] = s;
 
     // BFS to find an augmenting path
-    while( ! q.empty() && ! t->isVisited()) {
-        auto v = q.front();
-        q.pop();
-        // Process outgoing edges
-        for(auto e: v->getAdj()) {
-            testAndVisit(q, e, e->getDest(), e->getCapacity() - e->getFlow());
-        }
-        // Process incoming edges
-        for(auto e: v->getIncoming()) {
-            testAndVisit(q, e, e->getOrig(), e->getFlow());
+    while (head < tail && !visited[t]) {
+        uint32_t v = q[head++];
+        // Process the outgoing edges and the reverse arcs of the incoming edges
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            uint32_t w = heads[a];
+            // Check if 'w' is not visited, can be used and there is residual capacity
+            if (!visited[w] && activeVertices[w] && activeArcs[a] && capacities[a] - flows[a] > 0) {
+                // Mark 'w' as visited, set the path through which it was reached, and enqueue it
+                visited[w] = 1;
+                path[w] = a;
+                q[tail++] = w;
+            }
         }
     }
 
     // Return true if a path to the target is found, false otherwise
-    return t->isVisited();
+    return visited[t];
 }
 
 // Function to find the minimum residual capacity along the augmenting path
-double findMinResidualAlongPath(Vertex *s, Vertex *t) {
+double findMinResidualAlongPath(ResidualGraph &rg, const vector<int> &path) {
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    const vector<double> &capacities = rg.getArcCapacities();
+    const vector<double> &flows = rg.getArcFlows();
     double f = INF;
 
     // Traverse the augmenting path to find the minimum residual capacity
-    for (auto v = t; v != s; ) {
-        auto e = v->getPath();
-        if (e->getDest() == v) {
-            f = std::min(f, e->getCapacity() - e->getFlow());
-            v = e->getOrig();
-        }
-        else {
-            f = std::min(f, e->getFlow());
-            v = e->getDest();
-        }
+    for (uint32_t v = rg.getTarget(); v != rg.getSource(); ) {
+        int a = path[v];
+        f = std::min(f, capacities[a] - flows[a]);
+        v = heads[reverse[a]];
     }
 
     // Return the minimum residual capacity
@@ -64,179 +60,451 @@ double findMinResidualAlongPath(Vertex *s, Vertex *t) {
 }
 
 // Function to augment flow along the augmenting path with the given flow value
-void augmentFlowAlongPath(Vertex *s, Vertex *t, double f) {
+void augmentFlowAlongPath(ResidualGraph &rg, const vector<int> &path, double f) {
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    vector<double> &flows = rg.getArcFlows();
+
     // Traverse the augmenting path and update the flow values accordingly
-    for (auto v = t; v != s; ) {
-        auto e = v->getPath();
-        double flow = e->getFlow();
-        if (e->getDest() == v) {
-            e->setFlow(flow + f);
-            v = e->getOrig();
-        }
-        else {
-            e->setFlow(flow - f);
-            v = e->getDest();
-        }
+    for (uint32_t v = rg.getTarget(); v != rg.getSource(); ) {
+        int a = path[v];
+        flows[a] += f;
+        flows[reverse[a]] -= f;
+        v = heads[reverse[a]];
     }
 }
 
 // Main function implementing the Edmonds-Karp algorithm
-void edmondsKarp(Graph *g) {
-    // Find source and target vertices in the graph
-    Vertex* s = g->findVertex(g->getMainSourceCode());
-    Vertex* t = g->findVertex(g->getMainTargetCode());
+void edmondsKarp(ResidualGraph &rg) {
+    uint32_t s = rg.getSource();
+    uint32_t t = rg.getTarget();
 
     // Validate source and target vertices
-    if (s == nullptr || t == nullptr || s == t)
+    if (s == NO_VERTEX || t == NO_VERTEX || s == t)
         throw std::logic_error("Invalid source and/or target vertex");
 
+    // Buffers reused by every BFS
+    uint32_t n = rg.getNumVertices();
+    vector<int> path(n, -1);
+    vector<char> visited(n, 0);
+    vector<uint32_t> q(n);
+
     // While there is an augmenting path, augment the flow along the path
-    while( findAugmentingPath(g, s, t) ) {
-        double f = findMinResidualAlongPath(s, t);
-        augmentFlowAlongPath(s, t, f);
+    while( findAugmentingPath(rg, path, visited, q) ) {
+        double f = findMinResidualAlongPath(rg, path);
+        augmentFlowAlongPath(rg, path, f);
     }
+}
+
+// DINIC
+
+// Function to build the level graph using Breadth-First Search
+bool buildLevelGraph(ResidualGraph &rg, vector<int> &level, vector<uint32_t> &q) {
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<double> &capacities = rg.getArcCapacities();
+    const vector<double> &flows = rg.getArcFlows();
+    const vector<char> &activeVertices = rg.getActiveVertices();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+    uint32_t s = rg.getSource();
+    uint32_t t = rg.getTarget();
 
-    // Calculate and save incoming flow for each vertex
-    for (auto &pair : g->getVertexSet()) {
-        Vertex *v = pair.second;
-        double incomingFlow = 0;
-        for (auto e: v->getIncoming()) {
-            incomingFlow += e->getFlow();
+    // Mark all vertices as unreachable
+    std::fill(level.begin(), level.end(), -1);
+
+    // The source is at level 0
+    level[s] = 0;
+    int head = 0, tail = 0;
+    q[tail++] = s;
+
+    // BFS to assign to each vertex its distance from the source in the residual graph
+    while (head < tail) {
+        uint32_t v = q[head++];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            uint32_t w = heads[a];
+            if (level[w] == -1 && activeVertices[w] && activeArcs[a] && capacities[a] - flows[a] > 0) {
+                level[w] = level[v] + 1;
+                q[tail++] = w;
+            }
         }
-        v->setFlow(incomingFlow);
     }
+
+    // Return true if the target is reachable, false otherwise
+    return level[t] != -1;
 }
 
-// EDMONDS KARP WITH DEACTIVATED VERTEX
+// Function to find a blocking flow in the level graph
+void findBlockingFlow(ResidualGraph &rg, vector<int> &level, vector<int> &currentArc, vector<int> &path) {
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    const vector<double> &capacities = rg.getArcCapacities();
+    vector<double> &flows = rg.getArcFlows();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+    uint32_t s = rg.getSource();
+    uint32_t t = rg.getTarget();
 
-// Function to test the given vertex 'w' and visit it if conditions are met
-void testAndVisitWithDeactivatedVertex(std::queue< Vertex*> &q, Edge *e, Vertex *w, double residual, Vertex *deactivatedVertex) {
-    // Check if the vertex 'w' is not visited and there is residual capacity
-    if (! w->isVisited() && residual > 0 && (w->getCode() != deactivatedVertex->getCode())) {
-        // Mark 'w' as visited, set the path through which it was reached, and enqueue it
-        w->setVisited(true);
-        w->setPath(e);
-        q.push(w);
-    }
-}
+    // Every vertex starts scanning from its first arc
+    for (uint32_t v = 0; v < rg.getNumVertices(); v++) currentArc[v] = firstArc[v];
 
-// Function to find an augmenting path using Breadth-First Search
-bool findAugmentingPathWithDeactivatedVertex(Graph *g, Vertex *s, Vertex *t, Vertex *deactivatedVertex) {
-    // Mark all vertices as not visited
-    for(auto v : g->getVertexSet()) {
-        v.second->setVisited(false);
-    }
-    // Mark the source vertex as visited and enqueue it
-    s->setVisited(true);
-    std::queue<Vertex *> q;
-    q.push(s);
-    // BFS to find an augmenting path
-    while( ! q.empty() && ! t->isVisited()) {
-        auto v = q.front();
-        q.pop();
-        // Process outgoing edges
-        for(auto e: v->getAdj()) {
-            testAndVisitWithDeactivatedVertex(q, e, e->getDest(), e->getCapacity() - e->getFlow(), deactivatedVertex);
+    // 'path' holds the arcs from the source to 'v', which are all admissible
+    size_t length = 0;
+    uint32_t v = s;
+
+    while (true) {
+        if (v == t) {
+            // Find the minimum residual capacity along the path
+            double f = INF;
+            for (size_t i = 0; i < length; i++) {
+                int a = path[i];
+                f = std::min(f, capacities[a] - flows[a]);
+            }
+
+            // Augment the flow and retreat to the tail of the first saturated arc
+            size_t firstSaturated = length;
+            for (size_t i = 0; i < length; i++) {
+                int a = path[i];
+                flows[a] += f;
+                flows[reverse[a]] -= f;
+                if (firstSaturated == length && capacities[a] - flows[a] <= 0) firstSaturated = i;
+            }
+            length = firstSaturated;
+            v = length == 0 ? s : heads[path[length - 1]];
+            continue;
         }
-        // Process incoming edges
-        for(auto e: v->getIncoming()) {
-            testAndVisitWithDeactivatedVertex(q, e, e->getOrig(), e->getFlow(), deactivatedVertex);
+
+        // Advance along the current arc of 'v', skipping the arcs that are not admissible
+        int &a = currentArc[v];
+        while (a < firstArc[v + 1]) {
+            uint32_t w = heads[a];
+            if (level[w] == level[v] + 1 && activeArcs[a] && capacities[a] - flows[a] > 0) break;
+            a++;
         }
+
+        if (a < firstArc[v + 1]) {
+            path[length++] = a;
+            v = heads[a];
+            continue;
+        }
+
+        // 'v' cannot reach the target anymore, so it is removed from the level graph
+        if (v == s) break;
+        level[v] = -1;
+        length--;
+        v = length == 0 ? s : heads[path[length - 1]];
+        currentArc[v]++;
     }
-    // Return true if a path to the target is found, false otherwise
-    return t->isVisited();
 }
 
-// Main function implementing the Edmonds-Karp algorithm
-void edmondsKarpWithDeactivatedVertex(Graph *g, const string &deactivated) {
-    // Find source and target vertices in the graph
-    Vertex* s = g->findVertex(g->getMainSourceCode());
-    Vertex* t = g->findVertex(g->getMainTargetCode());
-    Vertex* deactivatedVertex = g->findVertex(deactivated);
+// Main function implementing the Dinic algorithm
+void dinic(ResidualGraph &rg) {
+    uint32_t s = rg.getSource();
+    uint32_t t = rg.getTarget();
+
     // Validate source and target vertices
-    if (s == nullptr || t == nullptr || s == t)
+    if (s == NO_VERTEX || t == NO_VERTEX || s == t)
         throw std::logic_error("Invalid source and/or target vertex");
 
-    // While there is an augmenting path, augment the flow along the path
-    while( findAugmentingPathWithDeactivatedVertex(g, s, t, deactivatedVertex) ) {
-        double f = findMinResidualAlongPath(s, t);
-        augmentFlowAlongPath(s, t, f);
-    }
+    // Buffers reused by every phase
+    uint32_t n = rg.getNumVertices();
+    vector<int> level(n, -1);
+    vector<uint32_t> q(n);
+    vector<int> currentArc(n);
+    vector<int> path(n);
 
-    // Calculate and save incoming flow for each vertex
-    for (auto &pair : g->getVertexSet()) {
-        Vertex *v = pair.second;
-        double incomingFlow = 0;
-        for (auto e: v->getIncoming()) {
-            incomingFlow += e->getFlow();
-        }
-        v->setFlow(incomingFlow);
+    // While the target is reachable, saturate the level graph with a blocking flow
+    while ( buildLevelGraph(rg, level, q) ) {
+        findBlockingFlow(rg, level, currentArc, path);
     }
 }
 
-// EDMONDS KARP WITH DEACTIVATED EDGE
+// PUSH-RELABEL
 
-// Function to test the given vertex 'w' and visit it if conditions are met
-void testAndVisitWithDeactivatedEdge(std::queue< Vertex*> &q, Edge *e, Vertex *w, double residual, const string &servicePointA, const string &servicePointB, bool unidirectional) {
-    // Check if the vertex 'w' is not visited and there is residual capacity
-    if (! w->isVisited() && residual > 0 && !(e->getOrig()->getCode() == servicePointA && e->getDest()->getCode() == servicePointB) ) {
+// Function to set the height of each vertex to its distance to 'sink' in the residual graph
+static void globalRelabel(ResidualGraph &rg, uint32_t sink, uint32_t excluded, vector<int> &height, vector<uint32_t> &q) {
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    const vector<double> &capacities = rg.getArcCapacities();
+    const vector<double> &flows = rg.getArcFlows();
+    const vector<char> &activeVertices = rg.getActiveVertices();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+    int n = (int) rg.getNumVertices();
 
-        if(!unidirectional) {
-            if(!(e->getOrig()->getCode() == servicePointB && e->getDest()->getCode() == servicePointA)) {
-                // Mark 'w' as visited, set the path through which it was reached, and enqueue it
-                w->setVisited(true);
-                w->setPath(e);
-                q.push(w);
+    // Vertices that cannot reach the sink keep the maximum height
+    std::fill(height.begin(), height.end(), n);
+
+    height[sink] = 0;
+    int head = 0, tail = 0;
+    q[tail++] = sink;
+
+    // Backward BFS from the sink, following the arcs that have residual capacity
+    while (head < tail) {
+        uint32_t w = q[head++];
+        for (int b = firstArc[w]; b < firstArc[w + 1]; b++) {
+            uint32_t v = heads[b];
+            int a = reverse[b];
+            if (height[v] == n && v != excluded && activeVertices[v] && activeArcs[a] && capacities[a] - flows[a] > 0) {
+                height[v] = height[w] + 1;
+                q[tail++] = v;
             }
-        } else {
-            // Mark 'w' as visited, set the path through which it was reached, and enqueue it
-            w->setVisited(true);
-            w->setPath(e);
-            q.push(w);
         }
     }
 }
 
-// Function to find an augmenting path using Breadth-First Search
-bool findAugmentingPathWithDeactivatedEdge(Graph *g, Vertex *s, Vertex *t, const string &servicePointA, const string &servicePointB, bool unidirectional) {
-    // Mark all vertices as not visited
-    for(auto v : g->getVertexSet()) {
-        v.second->setVisited(false);
-    }
-    // Mark the source vertex as visited and enqueue it
-    s->setVisited(true);
-    std::queue<Vertex *> q;
-    q.push(s);
-    // BFS to find an augmenting path
-    while( ! q.empty() && ! t->isVisited()) {
-        auto v = q.front();
-        q.pop();
-        // Process outgoing edges
-        for(auto e: v->getAdj()) {
-            testAndVisitWithDeactivatedEdge(q, e, e->getDest(), e->getCapacity() - e->getFlow(), servicePointA, servicePointB, unidirectional);
+// Function to discharge every vertex with excess, always choosing the highest one, until no vertex below the
+// maximum height has excess
+static void dischargeHighestLabel(ResidualGraph &rg, uint32_t sink, uint32_t excluded, vector<double> &excess) {
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    const vector<double> &capacities = rg.getArcCapacities();
+    vector<double> &flows = rg.getArcFlows();
+    const vector<char> &activeVertices = rg.getActiveVertices();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+    int n = (int) rg.getNumVertices();
+
+    vector<int> height(n);
+    vector<uint32_t> q(n);
+    vector<int> currentArc(n);
+    vector<int> count(n + 1);                 // number of vertices at each height
+    vector<vector<uint32_t>> buckets(n);      // vertices with excess at each height
+    int highest = -1;
+    int relabels = 0;
+
+    // Function to recompute the exact heights and the buckets
+    auto relabelAll = [&]() {
+        globalRelabel(rg, sink, excluded, height, q);
+        std::fill(count.begin(), count.end(), 0);
+        for (auto &bucket : buckets) bucket.clear();
+        highest = -1;
+        for (int v = 0; v < n; v++) {
+            currentArc[v] = firstArc[v];
+            count[height[v]]++;
+            if (excess[v] > 0 && (uint32_t) v != sink && (uint32_t) v != excluded && height[v] < n) {
+                buckets[height[v]].push_back(v);
+                highest = std::max(highest, height[v]);
+            }
         }
-        // Process incoming edges
-        for(auto e: v->getIncoming()) {
-            testAndVisitWithDeactivatedEdge(q, e, e->getOrig(), e->getFlow(), servicePointA, servicePointB, unidirectional);
+        relabels = 0;
+    };
+
+    relabelAll();
+
+    while (true) {
+        // Select the vertex with excess with the highest label
+        while (highest >= 0 && buckets[highest].empty()) highest--;
+        if (highest < 0) break;
+
+        uint32_t v = buckets[highest].back();
+        buckets[highest].pop_back();
+
+        // Skip the vertices that were lifted by the gap heuristic
+        if (height[v] != highest || excess[v] <= 0) continue;
+
+        // Discharge 'v'
+        while (excess[v] > 0) {
+            if (currentArc[v] == firstArc[v + 1]) {
+                // Relabel 'v' to one more than its lowest neighbour in the residual graph
+                int oldHeight = height[v];
+                int newHeight = n;
+                for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+                    uint32_t w = heads[a];
+                    if (w != excluded && activeVertices[w] && activeArcs[a] && capacities[a] - flows[a] > 0)
+                        newHeight = std::min(newHeight, height[w] + 1);
+                }
+
+                count[oldHeight]--;
+                relabels++;
+
+                // Gap heuristic: no vertex above an empty height can reach the sink anymore
+                if (count[oldHeight] == 0) {
+                    for (int u = 0; u < n; u++) {
+                        if (height[u] > oldHeight && height[u] < n) {
+                            count[height[u]]--;
+                            height[u] = n;
+                            count[n]++;
+                        }
+                    }
+                    newHeight = n;
+                }
+
+                height[v] = newHeight;
+                count[newHeight]++;
+                currentArc[v] = firstArc[v];
+                if (newHeight == n) break;
+                continue;
+            }
+
+            // Push as much excess as possible through the current arc if it is admissible
+            int a = currentArc[v];
+            uint32_t w = heads[a];
+            double residual = capacities[a] - flows[a];
+            if (w != excluded && activeVertices[w] && activeArcs[a] && residual > 0 && height[v] == height[w] + 1) {
+                double f = std::min(excess[v], residual);
+                flows[a] += f;
+                flows[reverse[a]] -= f;
+                excess[v] -= f;
+                if (excess[w] <= 0 && w != sink) {
+                    buckets[height[w]].push_back(w);
+                    highest = std::max(highest, height[w]);
+                }
+                excess[w] += f;
+                if (f < residual) continue;
+            }
+            currentArc[v]++;
         }
+
+        // Periodically recompute the exact heights
+        if (relabels >= n) relabelAll();
     }
-    // Return true if a path to the target is found, false otherwise
-    return t->isVisited();
 }
 
-// Main function implementing the Edmonds-Karp algorithm
-void edmondsKarpWithDeactivatedEdge(Graph *g, const string &servicePointA, const string &servicePointB, bool unidirectional) {
-    // Find source and target vertices in the graph
-    Vertex* s = g->findVertex(g->getMainSourceCode());
-    Vertex* t = g->findVertex(g->getMainTargetCode());
+// Main function implementing the highest-label push-relabel algorithm
+void pushRelabel(ResidualGraph &rg) {
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    const vector<double> &capacities = rg.getArcCapacities();
+    vector<double> &flows = rg.getArcFlows();
+    const vector<char> &activeVertices = rg.getActiveVertices();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+    uint32_t s = rg.getSource();
+    uint32_t t = rg.getTarget();
 
     // Validate source and target vertices
-    if (s == nullptr || t == nullptr || s == t)
+    if (s == NO_VERTEX || t == NO_VERTEX || s == t)
         throw std::logic_error("Invalid source and/or target vertex");
 
-    // While there is an augmenting path, augment the flow along the path
-    while( findAugmentingPathWithDeactivatedEdge(g, s, t, servicePointA, servicePointB, unidirectional) ) {
-        double f = findMinResidualAlongPath(s, t);
-        augmentFlowAlongPath(s, t, f);
+    // The excess of each vertex is the flow entering it minus the flow leaving it
+    uint32_t n = rg.getNumVertices();
+    vector<double> excess(n, 0);
+    for (uint32_t v = 0; v < n; v++) {
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) excess[v] -= flows[a];
+    }
+
+    // Saturate every arc leaving the source
+    for (int a = firstArc[s]; a < firstArc[s + 1]; a++) {
+        uint32_t w = heads[a];
+        double residual = capacities[a] - flows[a];
+        if (activeVertices[w] && activeArcs[a] && residual > 0) {
+            flows[a] += residual;
+            flows[reverse[a]] -= residual;
+            excess[s] -= residual;
+            excess[w] += residual;
+        }
     }
-}
\ No newline at end of file
+
+    // First phase: move as much excess as possible to the target
+    dischargeHighestLabel(rg, t, s, excess);
+
+    // Second phase: return the excess that cannot reach the target to the source, turning the preflow into a flow
+    dischargeHighestLabel(rg, s, t, excess);
+}
+
+// DOMINATOR TREE
+
+// Function to find the vertex with the smallest semi-dominator on the forest path above 'v', compressing the path
+static uint32_t evalDominator(uint32_t v, vector<uint32_t> &ancestor, vector<uint32_t> &label, const vector<int> &semi, vector<uint32_t> &stack) {
+    if (ancestor[v] == NO_VERTEX) return v;
+
+    // Collect the path up to the vertex below the root of its tree, then compress it from the top down
+    stack.clear();
+    for (uint32_t x = v; ancestor[ancestor[x]] != NO_VERTEX; x = ancestor[x]) stack.push_back(x);
+
+    while (!stack.empty()) {
+        uint32_t x = stack.back();
+        stack.pop_back();
+        uint32_t a = ancestor[x];
+        if (semi[label[a]] < semi[label[x]]) label[x] = label[a];
+        ancestor[x] = ancestor[a];
+    }
+    return label[v];
+}
+
+// Main function implementing the Lengauer-Tarjan algorithm
+void dominatorTree(const ResidualGraph &rg, vector<uint32_t> &idom) {
+    uint32_t s = rg.getSource();
+    uint32_t n = rg.getNumVertices();
+
+    if (s >= n)
+        throw std::logic_error("Invalid source vertex");
+
+    const vector<int> &firstArc = rg.getFirstArc();
+    const vector<uint32_t> &heads = rg.getArcHeads();
+    const vector<int> &reverse = rg.getArcReverse();
+    const vector<double> &capacities = rg.getArcCapacities();
+    const vector<char> &activeVertices = rg.getActiveVertices();
+    const vector<char> &activeArcs = rg.getActiveArcs();
+
+    // An arc is used if it is an active forward arc with positive capacity between active vertices
+    auto usable = [&](int a) {
+        return capacities[a] > 0 && activeArcs[a] && activeVertices[heads[a]];
+    };
+
+    vector<int> semi(n, -1);                // DFS number of the semi-dominator, -1 while unvisited
+    vector<uint32_t> vertexAt;              // vertex with each DFS number
+    vector<uint32_t> parent(n, NO_VERTEX);
+    vector<uint32_t> ancestor(n, NO_VERTEX);
+    vector<uint32_t> label(n);
+    vector<vector<uint32_t>> bucket(n);
+    vector<uint32_t> stack;
+    idom.assign(n, NO_VERTEX);
+
+    if (!activeVertices[s]) return;
+
+    // Number the vertices in DFS order, keeping the next arc to explore of each vertex in the stack
+    vertexAt.reserve(n);
+    vector<pair<uint32_t, int>> dfs;
+    dfs.emplace_back(s, firstArc[s]);
+    semi[s] = 0;
+    vertexAt.push_back(s);
+    label[s] = s;
+
+    while (!dfs.empty()) {
+        uint32_t v = dfs.back().first;
+        int &a = dfs.back().second;
+
+        if (a == firstArc[v + 1]) {
+            dfs.pop_back();
+            continue;
+        }
+        int arc = a++;
+        uint32_t w = heads[arc];
+        if (!usable(arc) || semi[w] != -1) continue;
+
+        semi[w] = (int) vertexAt.size();
+        vertexAt.push_back(w);
+        parent[w] = v;
+        label[w] = w;
+        dfs.emplace_back(w, firstArc[w]);
+    }
+
+    // Compute the semi-dominators in reverse DFS order, and the immediate dominators that follow from them
+    for (size_t i = vertexAt.size() - 1; i > 0; i--) {
+        uint32_t w = vertexAt[i];
+
+        // The predecessors of 'w' are the heads of its reverse arcs, whose pair is a usable forward arc into 'w'
+        for (int a = firstArc[w]; a < firstArc[w + 1]; a++) {
+            if (capacities[a] > 0 || !usable(reverse[a])) continue;
+            uint32_t v = heads[a];
+            if (semi[v] == -1) continue;
+
+            uint32_t u = evalDominator(v, ancestor, label, semi, stack);
+            if (semi[u] < semi[w]) semi[w] = semi[u];
+        }
+        bucket[vertexAt[semi[w]]].push_back(w);
+        ancestor[w] = parent[w];
+
+        for (uint32_t v : bucket[parent[w]]) {
+            uint32_t u = evalDominator(v, ancestor, label, semi, stack);
+            idom[v] = semi[u] < semi[v] ? u : parent[w];
+        }
+        bucket[parent[w]].clear();
+    }
+
+    for (size_t i = 1; i < vertexAt.size(); i++) {
+        uint32_t w = vertexAt[i];
+        if (idom[w] != vertexAt[semi[w]]) idom[w] = idom[idom[w]];
+    }
+}
@@ -3,230 +3,171 @@
 
 
 #include "Graph.h"
+#include "ResidualGraph.h"
 
 /**
- * @brief Checks if a vertex is unvisited and there is residual capacity, then marks it as visited,
- * sets the path through which it was reached, and enqueues it.
+ * @brief Finds an augmenting path in the residual graph using Breadth-First Search.
  *
- * @details This function is used in graph traversal algorithms to visit vertices while considering residual capacities.
- * It checks if the vertex 'w' is not visited and there is residual capacity, then marks 'w' as visited, sets the path
- * through which it was reached, and enqueues it for further processing.
+ * @details This function performs a Breadth-First Search (BFS) on the residual graph 'rg' starting from its source
+ * vertex to find an augmenting path leading to its target vertex. An arc can be traversed if it is active, leads to an
+ * active and unvisited vertex, and has residual capacity (capacity minus flow) greater than zero. The arc through which
+ * each vertex was first reached is saved in 'path', so the augmenting path can be traversed from the target back to the
+ * source. The buffers are reused between calls, so the search does not allocate memory.
  *
- * @param q Reference to a queue of Vertex pointers.
- * @param e Pointer to the edge connecting the current vertex to the vertex 'w'.
- * @param w Pointer to the vertex being tested and visited.
- * @param residual The residual capacity between the current vertex and 'w'.
- *
- * @complexity The time complexity of this function is O(1) since it performs simple operations such as checking
- * whether a vertex is visited and pushing it into a queue, which take constant time.
- */
-void testAndVisit(std::queue< Vertex*> &q, Edge *e, Vertex *w, double residual);
-
-/**
- * @brief Finds an augmenting path using Breadth-First Search.
- *
- * @details This function performs a Breadth-First Search (BFS) on the given graph 'g' starting from the source vertex 's'
- * to find an augmenting path leading to the target vertex 't'. It marks all vertices as unvisited initially, then marks
- * the source vertex 's' as visited and enqueues it. During BFS traversal, it processes outgoing and incoming edges of each
- * visited vertex to find an augmenting path.
- *
- * @param g Pointer to the graph in which the augmenting path is to be found.
- * @param s Pointer to the source vertex of the augmenting path.
- * @param t Pointer to the target vertex of the augmenting path.
+ * @param rg Reference to the residual graph in which the augmenting path is to be found.
+ * @param path Vector with one entry per vertex, filled with the arc through which each vertex was reached.
+ * @param visited Vector with one entry per vertex, used to mark the visited vertices.
+ * @param q Vector with one entry per vertex, used as the BFS queue.
  *
  * @return True if an augmenting path to the target is found, false otherwise.
  *
  * @complexity The time complexity of this function depends on the size of the graph and the number of edges. In the worst
  * case, where the graph has 'V' vertices and 'E' edges, the time complexity is O(V + E), as it performs BFS traversal.
  */
-bool findAugmentingPath(Graph *g, Vertex *s, Vertex *t);
+bool findAugmentingPath(ResidualGraph &rg, vector<int> &path, vector<char> &visited, vector<uint32_t> &q);
 
 /**
- * @brief Finds the minimum residual capacity along the augmenting path from the source 's' to the target 't'.
+ * @brief Finds the minimum residual capacity along the augmenting path from the source to the target.
  *
- * @details This function traverses the augmenting path from the target vertex 't' back to the source vertex 's'
- * to find the minimum residual capacity along the path. It iterates through the edges of the path, updating the
- * minimum residual capacity encountered. If the edge direction is from destination to origin, it calculates the
- * residual capacity as the edge capacity minus the flow. If the direction is from origin to destination, it calculates
- * the residual capacity as the flow. Finally, it returns the minimum residual capacity found along the augmenting path.
+ * @details This function traverses the augmenting path saved in 'path' from the target vertex back to the source
+ * vertex, and returns the minimum residual capacity (capacity minus flow) of the arcs along the path.
  *
- * @param s Pointer to the source vertex of the augmenting path.
- * @param t Pointer to the target vertex of the augmenting path.
+ * @param rg Reference to the residual graph containing the augmenting path.
+ * @param path Vector with the arc through which each vertex of the path was reached.
  *
- * @return The minimum residual capacity along the augmenting path from 's' to 't'.
+ * @return The minimum residual capacity along the augmenting path.
  *
  * @complexity The time complexity of this function depends on the length of the augmenting path, which is bounded
  * by the number of vertices in the graph. Therefore, in the worst case, where the path contains 'V' vertices, the time
- * complexity is O(V), as it iterates through each vertex on the path to find the minimum residual capacity.
+ * complexity is O(V).
  */
-double findMinResidualAlongPath(Vertex *s, Vertex *t);
+double findMinResidualAlongPath(ResidualGraph &rg, const vector<int> &path);
 
 /**
- * @brief Augments flow along the augmenting path from the source 's' to the target 't' with the given flow value 'f'.
+ * @brief Augments flow along the augmenting path from the source to the target with the given flow value 'f'.
  *
- * @details This function traverses the augmenting path from the target vertex 't' back to the source vertex 's'
- * and updates the flow values of the edges along the path accordingly. It iterates through the edges of the path,
- * updating the flow values based on the direction of the edges. If the edge direction is from destination to origin,
- * it adds the flow value 'f' to the current flow. If the direction is from origin to destination, it subtracts
- * the flow value 'f' from the current flow. Finally, it updates the flow values of the edges along the augmenting path.
+ * @details This function traverses the augmenting path saved in 'path' from the target vertex back to the source
+ * vertex, adding the flow value 'f' to each arc along the path and subtracting it from the paired reverse arc.
  *
- * @param s Pointer to the source vertex of the augmenting path.
- * @param t Pointer to the target vertex of the augmenting path.
+ * @param rg Reference to the residual graph containing the augmenting path.
+ * @param path Vector with the arc through which each vertex of the path was reached.
  * @param f The flow value to augment along the augmenting path.
  *
  * @complexity The time complexity of this function depends on the length of the augmenting path, which is bounded
  * by the number of vertices in the graph. Therefore, in the worst case, where the path contains 'V' vertices, the time
- * complexity is O(V), as it iterates through each vertex on the path to update the flow values of the edges.
+ * complexity is O(V).
  */
-void augmentFlowAlongPath(Vertex *s, Vertex *t, double f);
+void augmentFlowAlongPath(ResidualGraph &rg, const vector<int> &path, double f);
 
 /**
- * @brief Implements the Edmonds-Karp algorithm for finding the maximum flow in a graph.
+ * @brief Implements the Edmonds-Karp algorithm on a residual graph.
  *
- * @details This function implements the Edmonds-Karp algorithm, which finds the maximum flow from a source vertex 's'
- * to a target vertex 't' in a graph. It iterates through the graph until no augmenting path from 's' to 't' exists,
- * augmenting the flow along each found path. First, it finds the source and target vertices in the graph. Then, it
- * validates the source and target vertices. After that, it enters a loop where it repeatedly finds an augmenting path
- * using BFS, computes the minimum residual capacity along the path, and augments the flow along the path accordingly.
- * Once no augmenting path exists, the algorithm calculates and saves the incoming flow for each vertex in the graph.
+ * @details This function repeatedly finds an augmenting path from the source to the target of the residual graph using
+ * BFS, computes the minimum residual capacity along the path, and augments the flow along the path accordingly, until no
+ * augmenting path exists. Deactivated vertices and arcs of the residual graph are never used, and the algorithm continues
+ * from the flow currently stored in the residual graph.
  *
- * @param g Pointer to the graph on which the Edmonds-Karp algorithm is to be applied.
+ * @param rg Reference to the residual graph on which the Edmonds-Karp algorithm is to be applied.
  *
  * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
  *
- * @complexity The time complexity of this function depends on the number of iterations required to find the maximum flow.
- * In the worst case, where the algorithm iterates through all possible augmenting paths, the time complexity is O(V * E^2),
- * where 'V' is the number of vertices and 'E' is the number of edges in the graph.
+ * @complexity The time complexity of this function is O(V * E^2), where 'V' is the number of vertices and 'E' is the
+ * number of edges in the graph.
  */
-void edmondsKarp(Graph *g);
-
+void edmondsKarp(ResidualGraph &rg);
 
 /**
- * @brief Tests the given vertex 'w' and visits it if certain conditions are met.
+ * @brief Builds the level graph of the residual graph using Breadth-First Search.
+ *
+ * @details This function performs a Breadth-First Search (BFS) on the residual graph 'rg' starting from its source vertex
+ * and saves in 'level' the distance of each vertex from the source, using only active arcs with residual capacity that
+ * lead to active vertices. Unreachable vertices are given level -1. An arc belongs to the level graph when it goes from
+ * a vertex at level 'l' to a vertex at level 'l + 1'.
  *
- * @details This function checks if the vertex 'w' is not visited, if there is residual capacity, and if 'w' is not the same
- * as if the deactivated vertex. If all conditions are met, it marks 'w' as visited, sets the path through which it was reached,
- * and enqueues it for further processing.
+ * @param rg Reference to the residual graph whose level graph is to be built.
+ * @param level Vector with one entry per vertex, filled with the level of each vertex.
+ * @param q Vector with one entry per vertex, used as the BFS queue.
  *
- * @param q Reference to a queue of Vertex pointers.
- * @param e Pointer to the edge connecting the current vertex to the vertex 'w'.
- * @param w Pointer to the vertex being tested and visited.
- * @param residual The residual capacity between the current vertex and 'w'.
- * @param deactivatedVertex Pointer to the deactivated vertex. 'w' will not be visited if it matches this vertex.
+ * @return True if the target is reachable from the source, false otherwise.
  *
- * @complexity The time complexity of this function is O(1) since it performs simple operations such as checking
- * whether a vertex is visited and pushing it into a queue, which take constant time.
+ * @complexity The time complexity of this function is O(V + E), where 'V' is the number of vertices and 'E' is the
+ * number of edges in the graph.
  */
-void testAndVisitWithDeactivatedVertex(std::queue< Vertex*> &q, Edge *e, Vertex *w, double residual, Vertex *deactivatedVertex);
+bool buildLevelGraph(ResidualGraph &rg, vector<int> &level, vector<uint32_t> &q);
 
 /**
- * @brief Finds an augmenting path using Breadth-First Search (BFS), excluding a specified deactivated vertex.
+ * @brief Finds a blocking flow in the level graph of the residual graph.
  *
- * @details This function performs a Breadth-First Search (BFS) on the given graph 'g' starting from the source vertex 's'
- * to find an augmenting path leading to the target vertex 't'. It marks all vertices as unvisited initially, then marks
- * the source vertex 's' as visited and enqueues it. During BFS traversal, it processes outgoing and incoming edges of each
- * visited vertex to find an augmenting path, excluding the specified deactivated vertex from being visited.
+ * @details This function repeatedly advances from the source along arcs of the level graph until it reaches the target,
+ * augments the flow along the path found and retreats to the tail of the first saturated arc. Each vertex keeps a
+ * pointer to its current arc, so the arcs that were found to be saturated or leading to dead ends are never scanned
+ * again during the same phase. Vertices from which the target cannot be reached are removed from the level graph.
  *
- * @param g Pointer to the graph in which the augmenting path is to be found.
- * @param s Pointer to the source vertex of the augmenting path.
- * @param t Pointer to the target vertex of the augmenting path.
- * @param deactivatedVertex Pointer to the vertex that should not be visited during path finding.
+ * @param rg Reference to the residual graph in which the blocking flow is to be found.
+ * @param level Vector with the level of each vertex, as computed by buildLevelGraph.
+ * @param currentArc Vector with one entry per vertex, used to store the current arc of each vertex.
+ * @param path Vector with one entry per vertex, used to store the arcs of the current path.
  *
- * @return True if an augmenting path to the target is found, false otherwise.
- *
- * @complexity The time complexity of this function depends on the size of the graph and the number of edges. In the worst
- * case, where the graph has 'V' vertices and 'E' edges, the time complexity is O(V + E), as it performs BFS traversal.
+ * @complexity The time complexity of this function is O(V * E), where 'V' is the number of vertices and 'E' is the
+ * number of edges in the graph.
  */
-bool findAugmentingPathWithDeactivatedVertex(Graph *g, Vertex *s, Vertex *t, Vertex *deactivatedVertex);
+void findBlockingFlow(ResidualGraph &rg, vector<int> &level, vector<int> &currentArc, vector<int> &path);
 
 /**
- * @brief Implements the Edmonds-Karp algorithm for finding the maximum flow in a graph, excluding a specified deactivated vertex.
+ * @brief Implements the Dinic algorithm on a residual graph.
  *
- * @details This function implements the Edmonds-Karp algorithm, which finds the maximum flow from a source vertex 's'
- * to a target vertex 't' in a graph, while excluding a specified deactivated vertex from the path finding process. It iterates
- * through the graph until no augmenting path from 's' to 't' exists, augmenting the flow along each found path. First, it finds
- * the source and target vertices in the graph, as well as the deactivated vertex. Then, it validates the source and target vertices.
- * After that, it enters a loop where it repeatedly finds an augmenting path using BFS, computes the minimum residual capacity along
- * the path, and augments the flow along the path accordingly. Once no augmenting path exists, the algorithm calculates and saves
- * the incoming flow for each vertex in the graph, excluding the deactivated vertex from the flow calculation.
+ * @details This function repeatedly builds the level graph of the residual graph and saturates it with a blocking flow,
+ * until the target is no longer reachable from the source. Deactivated vertices and arcs of the residual graph are never
+ * used, and the algorithm continues from the flow currently stored in the residual graph.
  *
- * @param g Pointer to the graph on which the Edmonds-Karp algorithm is to be applied.
- * @param deactivated The code of the vertex to be deactivated during path finding.
+ * @param rg Reference to the residual graph on which the Dinic algorithm is to be applied.
  *
  * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
  *
- * @complexity The time complexity of this function depends on the number of iterations required to find the maximum flow.
- * In the worst case, where the algorithm iterates through all possible augmenting paths, the time complexity is O(V * E^2),
- * where 'V' is the number of vertices and 'E' is the number of edges in the graph.
- */
-void edmondsKarpWithDeactivatedVertex(Graph *g, const string &deactivated);
-
-
-/**
- * @brief Tests the given vertex 'w' and visits it if certain conditions are met, excluding a specified edge.
- *
- * @details This function checks if the vertex 'w' is not visited, if there is residual capacity, and if the edge connecting
- * 'w' to its origin and destination vertices does not match the specified service points. If all conditions are met,
- * it marks 'w' as visited, sets the path through which it was reached, and enqueues it for further processing. Additionally,
- * if the graph is bidirectional, it checks both directions of the edge. If unidirectional, it only checks the given direction.
- *
- * @param q Reference to a queue of Vertex pointers.
- * @param e Pointer to the edge connecting the current vertex to the vertex 'w'.
- * @param w Pointer to the vertex being tested and visited.
- * @param residual The residual capacity between the current vertex and 'w'.
- * @param servicePointA Code of the first service point to be excluded from the edge check.
- * @param servicePointB Code of the second service point to be excluded from the edge check.
- * @param unidirectional Flag indicating whether the graph is unidirectional or bidirectional.
- *
- * @complexity The time complexity of this function is O(1) since it performs simple operations such as checking
- * whether a vertex is visited and pushing it into a queue, which take constant time.
+ * @complexity The time complexity of this function is O(V^2 * E), where 'V' is the number of vertices and 'E' is the
+ * number of edges in the graph.
  */
-void testAndVisitWithDeactivatedEdge(std::queue< Vertex*> &q, Edge *e, Vertex *w, double residual, const string &servicePointA, const string &servicePointB, bool unidirectional);
+void dinic(ResidualGraph &rg);
 
 /**
- * @brief Finds an augmenting path using Breadth-First Search (BFS), excluding specified edges.
+ * @brief Implements the highest-label push-relabel algorithm on a residual graph.
  *
- * @details This function performs a Breadth-First Search (BFS) on the given graph 'g' starting from the source vertex 's'
- * to find an augmenting path leading to the target vertex 't'. It marks all vertices as unvisited initially, then marks
- * the source vertex 's' as visited and enqueues it. During BFS traversal, it processes outgoing and incoming edges of each
- * visited vertex to find an augmenting path, excluding edges that match the specified service points. Additionally, if the
- * graph is bidirectional, it checks both directions of each edge. If unidirectional, it only checks the given direction.
+ * @details This function saturates every arc leaving the source and then repeatedly discharges the vertex with excess
+ * that has the highest label, pushing excess along admissible arcs and relabelling the vertex when none is left. The
+ * labels are periodically recomputed with a backward BFS from the target (global relabelling), and whenever no vertex
+ * is left at some height, every vertex above it is lifted, since it can no longer reach the target (gap heuristic).
+ * In a second phase, the excess that cannot reach the target is returned to the source in the same way, so the preflow
+ * is turned into a valid flow. Deactivated vertices and arcs of the residual graph are never used, and the algorithm
+ * continues from the flow currently stored in the residual graph.
  *
- * @param g Pointer to the graph in which the augmenting path is to be found.
- * @param s Pointer to the source vertex of the augmenting path.
- * @param t Pointer to the target vertex of the augmenting path.
- * @param servicePointA Code of the first service point to be excluded from edge checks.
- * @param servicePointB Code of the second service point to be excluded from edge checks.
- * @param unidirectional Flag indicating whether the graph is unidirectional or bidirectional.
+ * @param rg Reference to the residual graph on which the push-relabel algorithm is to be applied.
  *
- * @return True if an augmenting path to the target is found, false otherwise.
+ * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
  *
- * @complexity The time complexity of this function depends on the size of the graph and the number of edges. In the worst
- * case, where the graph has 'V' vertices and 'E' edges, the time complexity is O(V + E), as it performs BFS traversal.
+ * @complexity The time complexity of this function is O(V^2 * sqrt(E)), where 'V' is the number of vertices and 'E' is
+ * the number of edges in the graph.
  */
-bool findAugmentingPathWithDeactivatedEdge(Graph *g, Vertex *s, Vertex *t, const string &servicePointA, const string &servicePointB, bool unidirectional);
+void pushRelabel(ResidualGraph &rg);
 
 /**
- * @brief Implements the Edmonds-Karp algorithm for finding the maximum flow in a graph, excluding specified edges.
+ * @brief Computes the dominator tree of a residual graph, rooted at its source, using the Lengauer-Tarjan algorithm.
  *
- * @details This function implements the Edmonds-Karp algorithm, which finds the maximum flow from a source vertex 's'
- * to a target vertex 't' in a graph, while excluding edges that match the specified service points. It iterates
- * through the graph until no augmenting path from 's' to 't' exists, augmenting the flow along each found path. First,
- * it finds the source and target vertices in the graph. Then, it validates the source and target vertices. After that,
- * it enters a loop where it repeatedly finds an augmenting path using BFS, computes the minimum residual capacity along
- * the path, and augments the flow along the path accordingly, excluding edges based on the specified service points.
+ * @details A vertex 'd' dominates a vertex 'v' if every path from the source to 'v' goes through 'd', so putting 'd'
+ * out of commission cuts 'v' off from the source completely. The immediate dominator of 'v' is the dominator closest to
+ * it, and following the immediate dominators from 'v' up to the source lists every dominator of 'v'. Only active
+ * vertices and active forward arcs with positive capacity are used, and the flow is ignored. The vertices are numbered
+ * by an iterative DFS, the semi-dominators are computed in reverse DFS order over a forest with path compression, and
+ * the immediate dominators are derived from them in a final pass in DFS order.
  *
- * @param g Pointer to the graph on which the Edmonds-Karp algorithm is to be applied.
- * @param servicePointA Code of the first service point to be excluded from edge checks.
- * @param servicePointB Code of the second service point to be excluded from edge checks.
- * @param unidirectional Flag indicating whether the graph is unidirectional or bidirectional.
+ * @param rg Reference to the residual graph.
+ * @param idom Vector where the immediate dominator of each vertex is stored. The entry of the source and of the vertices
+ * that cannot be reached from it is NO_VERTEX.
  *
- * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+ * @throws std::logic_error if the source vertex is invalid.
  *
- * @complexity The time complexity of this function depends on the number of iterations required to find the maximum flow.
- * In the worst case, where the algorithm iterates through all possible augmenting paths, the time complexity is O(V * E^2),
- * where 'V' is the number of vertices and 'E' is the number of edges in the graph.
+ * @complexity The time complexity of this function is O(E * log(V)), where 'V' is the number of vertices and 'E' is the
+ * number of edges in the graph.
  */
-void edmondsKarpWithDeactivatedEdge(Graph *g, const string &servicePointA, const string &servicePointB, bool unidirectional);
+void dominatorTree(const ResidualGraph &rg, vector<uint32_t> &idom);
 
 #endif //WATER_SUPPLY_ANALYSIS_SYSTEM_ALGORITHMS_H
@@ -1,16 +1,20 @@
 #include "App.h"
 #include "States/MainMenuState.h"
 #include "States/Utils/DataLoadError.h"
+#include "MaxFlowSolver.h"
 
 App* App::instance = nullptr;
 
 App::App() {
     currentState = new MainMenuState();
     data = nullptr;
+    solver = MaxFlowSolverRegistry::getInstance()->getDefaultSolver();
+    numThreads = 0;
 }
 
 App::~App() {
-    delete instance;
+    delete data;
+    instance = nullptr;
 }
 
 App *App::getInstance() {
@@ -29,13 +33,20 @@ void App::setState(State* state) {
 }
 
 void App::setData(const filesystem::path &dir_path) {
+    Data *newData = new Data();
     try {
-        Data *newData = new Data();
-        newData->readFiles(dir_path);
-        this->data = newData;
+        newData->setMaxFlowSolver(solver);
+        newData->setNumThreads(numThreads);
+        if(filesystem::is_regular_file(dir_path)) newData->readSnapshot(dir_path);
+        else newData->readFiles(dir_path);
     } catch (const exception& e) {
+        delete newData;
         throw DataLoadError(e.what());
     }
+
+    // The previous network is released only once the new one is loaded
+    delete this->data;
+    this->data = newData;
 }
 
 void App::display() const {
@@ -55,3 +66,21 @@ void App::handleInput() {
 Data *App::getData() {
     return data;
 }
+
+const MaxFlowSolver *App::getMaxFlowSolver() const {
+    return solver;
+}
+
+void App::setMaxFlowSolver(const MaxFlowSolver *maxFlowSolver) {
+    this->solver = maxFlowSolver;
+    if(data != nullptr) data->setMaxFlowSolver(maxFlowSolver);
+}
+
+unsigned int App::getNumThreads() const {
+    return numThreads;
+}
+
+void App::setNumThreads(unsigned int threads) {
+    this->numThreads = threads;
+    if(data != nullptr) data->setNumThreads(threads);
+}
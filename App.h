@@ -14,6 +14,8 @@ private:
     static App* instance;
     State* currentState;
     Data* data;
+    const MaxFlowSolver* solver;
+    unsigned int numThreads;
 
     /**
     * @brief Constructor for the App class.
@@ -25,7 +27,7 @@ public:
     /**
     * @brief Destructor for the App class.
     *
-    * @details Deallocates the memory occupied by the App instance.
+    * @details Deallocates the loaded network and clears the singleton instance.
     */
     ~App();
 
@@ -64,12 +66,47 @@ public:
     /**
     * @brief Sets the data of the application.
     *
-    * @details This method sets the data of the application to the water network in the given path.
+    * @details This method sets the data of the application to the water network in the given path, which is either a
+    * directory with the network files or a network snapshot. The previously loaded network is released once the new
+    * one is loaded, and kept if loading fails.
     *
-    * @param dir_path A path to the water network files.
+    * @param dir_path A path to the water network files, or to a network snapshot.
     */
     void setData(const filesystem::path &dir_path);
 
+    /**
+    * @brief Gets the max-flow solver selected for the application.
+    *
+    * @return A pointer to the selected solver, or the default solver if none was selected.
+    */
+    const MaxFlowSolver *getMaxFlowSolver() const;
+
+    /**
+    * @brief Sets the max-flow solver of the application.
+    *
+    * @details This method selects the solver used by every network loaded afterwards. If a network is already
+    * loaded, its maximum flow is recomputed with the new solver.
+    *
+    * @param maxFlowSolver A pointer to the solver to be used.
+    */
+    void setMaxFlowSolver(const MaxFlowSolver *maxFlowSolver);
+
+    /**
+    * @brief Gets the number of threads used by the failure sweeps.
+    *
+    * @return The number of threads, or 0 if one thread per hardware thread is used.
+    */
+    unsigned int getNumThreads() const;
+
+    /**
+    * @brief Sets the number of threads used by the failure sweeps.
+    *
+    * @details This method applies to every network loaded afterwards and to the network already loaded.
+    *
+    * @param threads The number of threads, or 0 to use one thread per hardware thread.
+    */
+    void setNumThreads(unsigned int threads);
+
     /**
     * @brief Displays the current state of the application.
     */
@@ -0,0 +1,105 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_ARENA_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_ARENA_H
+
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+* @brief Pool allocator that owns every object created through it.
+*
+* @details Objects are constructed in place inside fixed-size blocks, so objects created one after the other are
+* contiguous in memory, and pointers to them stay valid until the arena is cleared or destroyed, since blocks are
+* never moved. Objects cannot be released one by one: all of them are destroyed in one shot by clear() or by the
+* destructor. An arena cannot be copied, since it owns its objects.
+*
+* @tparam T Type of the objects in the arena.
+*/
+template <class T>
+class Arena {
+private:
+    static constexpr size_t BLOCK_SIZE = 256;   // objects per block
+
+    vector<T *> blocks;
+    size_t used = BLOCK_SIZE;                   // objects constructed in the last block
+
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Destructor for the Arena class.
+     *
+     * @details Destroys every object of the arena and releases its memory.
+     */
+    ~Arena() {
+        clear();
+    }
+
+    /**
+     * @brief Constructs a new object in the arena.
+     *
+     * @param args Arguments forwarded to the constructor of T.
+     *
+     * @return Pointer to the new object, owned by the arena.
+     *
+     * @complexity O(1) amortized, plus the complexity of the constructor of T.
+     */
+    template <class... Args>
+    T *create(Args &&... args) {
+        if(used == BLOCK_SIZE) {
+            blocks.push_back(static_cast<T *>(::operator new(BLOCK_SIZE * sizeof(T))));
+            used = 0;
+        }
+        T *object = new (blocks.back() + used) T(std::forward<Args>(args)...);
+        used++;
+        return object;
+    }
+
+    /**
+     * @brief Destroys every object of the arena and releases its memory.
+     *
+     * @complexity O(n), where n is the number of objects in the arena.
+     */
+    void clear() {
+        for(size_t b = 0; b < blocks.size(); b++) {
+            size_t count = (b + 1 == blocks.size()) ? used : BLOCK_SIZE;
+            for(size_t i = 0; i < count; i++) blocks[b][i].~T();
+            ::operator delete(blocks[b]);
+        }
+        blocks.clear();
+        used = BLOCK_SIZE;
+    }
+
+    /**
+     * @brief Get the number of objects in the arena.
+     *
+     * @return The number of objects in the arena.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] size_t size() const {
+        return blocks.empty() ? 0 : (blocks.size() - 1) * BLOCK_SIZE + used;
+    }
+
+    /**
+     * @brief Get an object of the arena by its position in creation order.
+     *
+     * @param i The position of the object, less than size().
+     *
+     * @return Pointer to the object.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] T *get(size_t i) const {
+        return blocks[i / BLOCK_SIZE] + i % BLOCK_SIZE;
+    }
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_ARENA_H
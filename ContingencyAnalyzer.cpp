@@ -0,0 +1,159 @@
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "ContingencyAnalyzer.h"
+
+ContingencyAnalyzer::ContingencyAnalyzer(Graph *g, vector<FailureCase> components, unsigned int numThreads)
+        : prototype(g), solver(g->getMaxFlowSolver()), components(std::move(components)), numThreads(numThreads) {
+    if(this->numThreads == 0) this->numThreads = max(1u, thread::hardware_concurrency());
+    baselineFlow = prototype.getSuppliedFlow();
+}
+
+double ContingencyAnalyzer::getBaselineFlow() const {
+    return baselineFlow;
+}
+
+void ContingencyAnalyzer::deactivate(Worker &worker, uint32_t c) const {
+    const FailureCase &f = components[c];
+
+    // Components are distinct, so no two members share a vertex
+    if(f.vertex != NO_VERTEX) {
+        worker.rg.deactivateVertex(f.vertex);
+        return;
+    }
+    worker.rg.getEdgeArcs(f.servicePointA, f.servicePointB, f.unidirectional, worker.arcs);
+    for(int a : worker.arcs) worker.arcFailures[a]++;
+    worker.rg.deactivateEdge(f.servicePointA, f.servicePointB, f.unidirectional);
+}
+
+bool ContingencyAnalyzer::fail(Worker &worker, uint32_t c) const {
+    const FailureCase &f = components[c];
+    ResidualGraph &rg = worker.rg;
+
+    bool hasFlow = f.vertex != NO_VERTEX
+            ? rg.getIncomingFlow(f.vertex) > 0
+            : rg.hasFlowThroughEdge(f.servicePointA, f.servicePointB, f.unidirectional);
+
+    // A component without flow cannot change the flow, it only has to be kept out of the paths of deeper levels
+    if(!hasFlow) {
+        deactivate(worker, c);
+        worker.stats.skipped++;
+        return false;
+    }
+
+    rg.saveFlows(worker.savedFlows[worker.members.size() - 1]);
+
+    if(f.vertex != NO_VERTEX) rg.cancelFlowThroughVertex(f.vertex);
+    else rg.cancelFlowThroughEdge(f.servicePointA, f.servicePointB, f.unidirectional);
+    deactivate(worker, c);
+    solver->solve(rg);
+    worker.stats.solved++;
+    return true;
+}
+
+void ContingencyAnalyzer::repair(Worker &worker, uint32_t c) const {
+    const FailureCase &f = components[c];
+
+    if(f.vertex != NO_VERTEX) {
+        worker.rg.activateVertex(f.vertex);
+        return;
+    }
+    worker.rg.getEdgeArcs(f.servicePointA, f.servicePointB, f.unidirectional, worker.arcs);
+    for(int a : worker.arcs) {
+        if(--worker.arcFailures[a] == 0) worker.rg.activateArc(a);
+    }
+}
+
+void ContingencyAnalyzer::visit(Worker &worker, unsigned int k, uint32_t c) const {
+    worker.members.push_back(c);
+    bool changed = fail(worker, c);
+
+    if(worker.members.size() == k) {
+        worker.stats.combinations++;
+        double maxFlow = worker.rg.getSuppliedFlow();
+        if(maxFlow < baselineFlow) worker.results.push_back({worker.members, maxFlow});
+    }
+    else {
+        explore(worker, k, c + 1);
+    }
+
+    // Go back to the flow of the level above, which is the warm start of the next component
+    if(changed) worker.rg.restoreFlows(worker.savedFlows[worker.members.size() - 1]);
+    repair(worker, c);
+    worker.members.pop_back();
+}
+
+void ContingencyAnalyzer::explore(Worker &worker, unsigned int k, uint32_t first) const {
+    size_t missing = k - worker.members.size();
+
+    for(uint32_t c = first; c + missing <= components.size(); c++) {
+        visit(worker, k, c);
+    }
+}
+
+ContingencyStats ContingencyAnalyzer::run(unsigned int k, const function<void(const ContingencyResult &)> &report) const {
+    ContingencyStats stats;
+    uint32_t n = (uint32_t) components.size();
+    if(k == 0 || k > n) return stats;
+
+    // Only the first components that can start a combination are handed out
+    uint32_t firsts = n - k + 1;
+    size_t numWorkers = min<size_t>(numThreads, firsts);
+    uint32_t batchSize = (uint32_t) numWorkers * 4;
+
+    vector<Worker> workers;
+    workers.reserve(numWorkers);
+    for(size_t w = 0; w < numWorkers; w++) {
+        workers.push_back({prototype, vector<vector<double>>(k), vector<uint32_t>(prototype.getNumArcs(), 0), {}, {}, {},
+                           {}});
+        workers.back().members.reserve(k);
+    }
+
+    for(uint32_t start = 0; start < firsts; start += batchSize) {
+        uint32_t end = min(firsts, start + batchSize);
+        vector<vector<ContingencyResult>> batchResults(end - start);
+        atomic<uint32_t> next(start);
+        exception_ptr error = nullptr;
+        mutex errorMutex;
+
+        // Every worker explores the combinations that start with the components it picked up
+        auto work = [&](Worker &worker) {
+            try {
+                for(uint32_t c = next++; c < end; c = next++) {
+                    visit(worker, k, c);
+                    batchResults[c - start] = std::move(worker.results);
+                    worker.results.clear();
+                }
+            }
+            catch(...) {
+                lock_guard<mutex> lock(errorMutex);
+                if(error == nullptr) error = current_exception();
+                next = end;
+            }
+        };
+
+        if(numWorkers <= 1) {
+            work(workers[0]);
+        }
+        else {
+            vector<thread> threads;
+            threads.reserve(numWorkers);
+            for(Worker &worker : workers) threads.emplace_back(work, ref(worker));
+            for(thread &t : threads) t.join();
+        }
+
+        if(error != nullptr) rethrow_exception(error);
+
+        for(const vector<ContingencyResult> &results : batchResults) {
+            for(const ContingencyResult &result : results) report(result);
+        }
+    }
+
+    for(const Worker &worker : workers) {
+        stats.combinations += worker.stats.combinations;
+        stats.solved += worker.stats.solved;
+        stats.skipped += worker.stats.skipped;
+    }
+    return stats;
+}
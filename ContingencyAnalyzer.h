@@ -0,0 +1,178 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_CONTINGENCY_ANALYZER_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_CONTINGENCY_ANALYZER_H
+
+
+#include <functional>
+#include <vector>
+#include "Graph.h"
+#include "ResidualGraph.h"
+#include "MaxFlowSolver.h"
+#include "FailureSweep.h"
+
+using namespace std;
+
+/**
+* @brief Result of one combination of failures of a contingency analysis.
+*/
+struct ContingencyResult {
+    vector<uint32_t> members;   // indexes of the failed components, in increasing order
+    double maxFlow = 0;         // water supplied to the delivery sites with all the members out of commission
+};
+
+/**
+* @brief Counters of the work done by a contingency analysis.
+*/
+struct ContingencyStats {
+    size_t combinations = 0;    // combinations of k components evaluated
+    size_t solved = 0;          // failures re-routed by the max-flow solver
+    size_t skipped = 0;         // failures of components without flow, which keep the flow they started from
+};
+
+/**
+* @brief Evaluates every combination of k simultaneous failures (N-k contingencies) of a network.
+*
+* @details The combinations are enumerated in lexicographic order as a depth-first search, where every level puts one
+* more component out of commission on top of the flow of the level above it. The flow of a (k-1)-subset is therefore
+* repaired once and reused as the warm start of all of its extensions, and only the flow lost by the new component has to
+* be re-routed. A component that carries no flow in the state it is added to cannot change that flow, so its failure
+* costs no solve at all.
+*
+* The search is split by its first component among worker threads, each with its own residual graph and one saved flow
+* per level, so the memory of a worker is O(k * E). The first components are handed out in batches, and the results of a
+* batch are reported in order before the next batch starts, so the results held in memory are bounded by one batch and
+* the report does not depend on the number of threads.
+*/
+class ContingencyAnalyzer {
+private:
+    ResidualGraph prototype;
+    const MaxFlowSolver *solver;
+    vector<FailureCase> components;
+    unsigned int numThreads;
+    double baselineFlow;
+
+    /**
+     * @brief State of a worker: its residual graph, the flow saved before each level of the search and the number of
+     * current members that keep each forward arc out of commission.
+     */
+    struct Worker {
+        ResidualGraph rg;
+        vector<vector<double>> savedFlows;
+        vector<uint32_t> arcFailures;
+        vector<int> arcs;
+        vector<uint32_t> members;
+        vector<ContingencyResult> results;
+        ContingencyStats stats;
+    };
+
+    /**
+     * @brief Deactivates a component in the residual graph of a worker, counting the failures of its arcs.
+     *
+     * @details Pipelines listed in both directions share arcs, so an arc is only activated again by repair() once no
+     * member keeps it out of commission.
+     *
+     * @param worker The worker.
+     * @param c The index of the component.
+     *
+     * @complexity O(d), where d is the number of arcs of the component.
+     */
+    void deactivate(Worker &worker, uint32_t c) const;
+
+    /**
+     * @brief Puts a component out of commission on top of the current flow of a worker.
+     *
+     * @param worker The worker.
+     * @param c The index of the component.
+     *
+     * @return True if the flow of the worker changed and has to be restored afterwards, false otherwise.
+     *
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the component, plus the complexity of the solver.
+     */
+    bool fail(Worker &worker, uint32_t c) const;
+
+    /**
+     * @brief Puts a component back into commission, keeping the arcs other members still keep out of commission.
+     *
+     * @param worker The worker.
+     * @param c The index of the component.
+     *
+     * @complexity O(d), where d is the number of arcs of the component.
+     */
+    void repair(Worker &worker, uint32_t c) const;
+
+    /**
+     * @brief Adds a component to the current members of a worker, evaluates the combinations that extend them, and
+     * removes it again.
+     *
+     * @details If the members reach k components, the combination is evaluated and reported if it lowers the max flow.
+     * Otherwise, every combination that extends the members is explored. Afterwards, the flow and the active state of
+     * the worker are restored.
+     *
+     * @param worker The worker.
+     * @param k The size of the combinations.
+     * @param c The index of the component.
+     *
+     * @complexity O(C(n - c - 1, k - depth - 1)) failures, where n is the number of components and depth is the number
+     * of current members.
+     */
+    void visit(Worker &worker, unsigned int k, uint32_t c) const;
+
+    /**
+     * @brief Enumerates every combination that extends the current members of a worker.
+     *
+     * @param worker The worker.
+     * @param k The size of the combinations.
+     * @param first The index of the first component that can be added.
+     *
+     * @complexity O(C(n - first, k - depth)) failures, where n is the number of components and depth is the number of
+     * current members.
+     */
+    void explore(Worker &worker, unsigned int k, uint32_t first) const;
+
+public:
+
+    /**
+     * @brief Builds an analyzer for the given graph.
+     *
+     * @details The current flow of the graph is taken as the baseline, so the graph must hold its max flow.
+     * Failures are repaired with the max-flow solver of the graph.
+     *
+     * @param g Pointer to the graph to be analyzed.
+     * @param components The components that can fail, each one described by a failure case.
+     * @param numThreads The number of worker threads, or 0 to use one per hardware thread.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    ContingencyAnalyzer(Graph *g, vector<FailureCase> components, unsigned int numThreads);
+
+    /**
+     * @brief Get the water supplied to the delivery sites without any failure.
+     *
+     * @return The baseline max flow.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] double getBaselineFlow() const;
+
+    /**
+     * @brief Evaluates every combination of k components out of commission.
+     *
+     * @details Only the combinations that supply less water than the baseline are reported. They are reported in
+     * lexicographic order of their members, on the calling thread. If a worker fails, the first error is rethrown once
+     * all workers have finished.
+     *
+     * @param k The number of simultaneous failures, at least 1.
+     * @param report Function called with every combination that lowers the max flow.
+     *
+     * @return The counters of the work done.
+     *
+     * @throws std::logic_error if the max-flow solver fails.
+     *
+     * @complexity O(C(n, k) * (V + E + F) / T) in the worst case, where n is the number of components, F is the complexity
+     * of repairing the flow of one failure and T is the number of threads. Failures of components without flow cost
+     * O(d).
+     */
+    ContingencyStats run(unsigned int k, const function<void(const ContingencyResult &)> &report) const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_CONTINGENCY_ANALYZER_H
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <system_error>
+#include <utility>
+#include "CsvReader.h"
+
+bool CsvReader::open(const filesystem::path &path) {
+    position = 0;
+    if(!file.open(path, true)) return false;
+
+    // Skip the UTF-8 byte order mark
+    if(file.size() >= 3 && memcmp(file.data(), "\xEF\xBB\xBF", 3) == 0) position = 3;
+    return true;
+}
+
+void CsvReader::close() {
+    file.close();
+    position = 0;
+}
+
+const char *CsvReader::data() const {
+    return file.data();
+}
+
+size_t CsvReader::size() const {
+    return file.size();
+}
+
+bool CsvReader::nextRow(vector<string_view> &fields) {
+    return nextRow(position, file.size(), fields);
+}
+
+vector<pair<size_t, size_t>> CsvReader::splitRows(size_t numChunks) const {
+    vector<pair<size_t, size_t>> chunks;
+    const char *contents = file.data();
+    size_t size = file.size();
+    size_t begin = position;
+
+    for(size_t i = 1; i <= numChunks && begin < size; i++) {
+        // Every chunk but the last ends right after the first line break at or past its share of the bytes
+        size_t end = size;
+        if(i < numChunks) {
+            end = max(begin, position + (size - position) / numChunks * i);
+            const void *lineBreak = memchr(contents + end, '\n', size - end);
+            end = lineBreak == nullptr ? size : (size_t) (static_cast<const char *>(lineBreak) - contents) + 1;
+        }
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+    return chunks;
+}
+
+bool CsvReader::nextRow(size_t &offset, size_t limit, vector<string_view> &fields) {
+    fields.clear();
+    if(offset >= limit) return false;
+
+    // A row that starts before the limit is read whole, even if it goes past it
+    char *contents = file.data();
+    char *end = contents + file.size();
+    char *p = contents + offset;
+
+    while(true) {
+        char *start = p;
+        char *fieldEnd;
+
+        if(p < end && *p == '"') {
+            // Quoted field: collapse doubled quotes in place, so the field stays contiguous
+            char *out = ++p;
+            start = out;
+            while(p < end) {
+                if(*p == '"') {
+                    if(p + 1 < end && p[1] == '"') {
+                        *out++ = '"';
+                        p += 2;
+                        continue;
+                    }
+                    p++;
+                    break;
+                }
+                // Bytes are only moved after a doubled quote, so other pages of the mapping are never copied
+                if(out != p) *out = *p;
+                out++;
+                p++;
+            }
+            fieldEnd = out;
+
+            // Anything between the closing quote and the separator is dropped
+            while(p < end && *p != ',' && *p != '\n') p++;
+        }
+        else {
+            while(p < end && *p != ',' && *p != '\n') p++;
+            fieldEnd = p;
+            if(fieldEnd > start && fieldEnd[-1] == '\r' && (p == end || *p == '\n')) fieldEnd--;
+        }
+
+        fields.emplace_back(start, (size_t) (fieldEnd - start));
+
+        if(p < end && *p == ',') {
+            p++;
+            continue;
+        }
+        if(p < end) p++;
+        break;
+    }
+
+    offset = (size_t) (p - contents);
+    return true;
+}
+
+bool CsvReader::parseNumber(string_view field, double &value) {
+    value = 0;
+
+    size_t first = field.find_first_not_of(" \t");
+    if(first == string_view::npos) return false;
+    size_t last = field.find_last_not_of(" \t");
+    field = field.substr(first, last - first + 1);
+
+    // Thousands separators are dropped into a small stack buffer, the common case parses the field directly
+    char digits[64];
+    if(field.find(',') != string_view::npos) {
+        size_t n = 0;
+        for(char c : field) {
+            if(c == ',') continue;
+            if(n == sizeof(digits)) return false;
+            digits[n++] = c;
+        }
+        field = string_view(digits, n);
+    }
+
+    const char *begin = field.data();
+    if(!field.empty() && field[0] == '+') begin++;
+
+    from_chars_result result = from_chars(begin, field.data() + field.size(), value);
+    if(result.ec != errc()) {
+        value = 0;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_CSV_READER_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_CSV_READER_H
+
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "MappedFile.h"
+
+using namespace std;
+
+/**
+* @brief Reader of CSV files that maps the file into memory and splits its rows in place.
+*
+* @details The file is mapped copy-on-write, so fields are returned as views into the mapping, without copying a line
+* or allocating a string per field. A UTF-8 byte order mark at the start of the file is skipped. Fields may be quoted,
+* like the population "2,517", in which case the quotes are removed, separators and line breaks inside them are kept,
+* and doubled quotes are collapsed in place. Lines may end with "\n" or "\r\n". When the file cannot be mapped, it is
+* read into a buffer and split the same way. The fields stay valid while the reader is alive.
+*/
+class CsvReader {
+private:
+    MappedFile file;            // contents of the file, writable to unescape quoted fields
+    size_t position = 0;        // offset of the next row
+
+public:
+    CsvReader() = default;
+    CsvReader(const CsvReader &) = delete;
+    CsvReader &operator=(const CsvReader &) = delete;
+
+    /**
+     * @brief Opens a file, closing the file opened before.
+     *
+     * @param path The path of the file.
+     *
+     * @return True if the file was opened, false if it cannot be read.
+     *
+     * @complexity O(1) when the file is mapped, O(n) when it is read into a buffer, where n is the size of the file.
+     */
+    bool open(const filesystem::path &path);
+
+    /**
+     * @brief Closes the file, invalidating every field read from it.
+     */
+    void close();
+
+    /**
+     * @brief Get the contents of the file.
+     *
+     * @return Pointer to the bytes of the file, including any byte order mark.
+     */
+    [[nodiscard]] const char *data() const;
+
+    /**
+     * @brief Get the size of the file.
+     *
+     * @return The size of the file in bytes.
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Splits the next row of the file into its fields.
+     *
+     * @details The views stay valid until the reader is destroyed or opens another file. Quoted fields are unescaped
+     * in the private mapping of the file, never in the file itself.
+     *
+     * @param fields The vector where the fields of the row are stored, replacing its contents.
+     *
+     * @return True if a row was read, false at the end of the file.
+     *
+     * @complexity O(l), where l is the length of the row.
+     */
+    bool nextRow(vector<string_view> &fields);
+
+    /**
+     * @brief Splits the rows left in the file into byte ranges that can be parsed independently.
+     *
+     * @details The rows after the current position are split into ranges of about the same size, each one ending right
+     * after a line break, so every range holds whole rows. A quoted field holding a line break could be cut in two, so
+     * files with such fields must be read row by row instead. The current position is not moved.
+     *
+     * @param numChunks The number of ranges wanted. Fewer are returned if the file has fewer lines.
+     *
+     * @return The [begin, end) byte offsets of the ranges, in file order.
+     *
+     * @complexity O(k + l), where k is the number of ranges and l is the length of the longest line.
+     */
+    [[nodiscard]] vector<pair<size_t, size_t>> splitRows(size_t numChunks) const;
+
+    /**
+     * @brief Splits the row at a byte offset of the file into its fields.
+     *
+     * @details Unlike nextRow(vector<string_view> &), the offset is kept by the caller, so several threads can parse
+     * the disjoint ranges given by splitRows() at the same time.
+     *
+     * @param offset The byte offset of the row, moved to the start of the next row.
+     * @param limit The end of the range being read.
+     * @param fields The vector where the fields of the row are stored, replacing its contents.
+     *
+     * @return True if a row was read, false if the offset reached the limit.
+     *
+     * @complexity O(l), where l is the length of the row.
+     */
+    bool nextRow(size_t &offset, size_t limit, vector<string_view> &fields);
+
+    /**
+     * @brief Parses a number, ignoring surrounding spaces and thousands separators like the one in "2,517".
+     *
+     * @param field The field holding the number.
+     * @param value The parsed number, or 0 if the field does not start with one.
+     *
+     * @return True if the field starts with a number.
+     *
+     * @complexity O(l), where l is the length of the field.
+     */
+    static bool parseNumber(string_view field, double &value);
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_CSV_READER_H
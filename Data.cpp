@@ -1,17 +1,297 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <set>
+#include <thread>
 #include "Data.h"
+#include "FailureAnalyzer.h"
+#include "Algorithms.h"
+#include "ContingencyAnalyzer.h"
+#include "ReliabilitySimulator.h"
 
 Data::Data() = default;
 
+Data::~Data() {
+    for(auto &pair : waterReservoirs) delete pair.second;
+    for(auto &pair : pumpingStations) delete pair.second;
+    for(auto &pair : deliverySites) delete pair.second;
+}
+
 string Data::getNetworkName() const {
     return networkName;
 }
 
+const MaxFlowSolver *Data::getMaxFlowSolver() const {
+    return g.getMaxFlowSolver();
+}
+
+void Data::setMaxFlowSolver(const MaxFlowSolver *solver) {
+    g.setMaxFlowSolver(solver);
+
+    if(networkName.empty()) return;
+
+    g.setAllEdgesFlow(0);
+    g.setAllVerticesFlow(0);
+    g.runMaxFlow();
+    metrics = g.calculateMetrics();
+    openImpactCache();
+}
+
+unsigned int Data::getNumThreads() const {
+    return numThreads;
+}
+
+void Data::setNumThreads(unsigned int threads) {
+    numThreads = threads;
+}
+
+vector<uint32_t> Data::getDeliverySiteIds() const {
+    vector<uint32_t> ids;
+    ids.reserve(deliverySites.size());
+    for(const auto &pair : deliverySiteOrder) ids.push_back(pair.second->getVertexId());
+    return ids;
+}
+
+void Data::openImpactCache() {
+    string solverName = g.getMaxFlowSolver()->getName();
+    uint64_t fingerprint = ImpactCache::hash(solverName.data(), solverName.size(), inputsFingerprint);
+
+    vector<string> siteCodes;
+    for(const auto &pair : deliverySiteOrder) siteCodes.push_back(pair.first);
+
+    impactCache.open(filesystem::current_path() / ".." / "output" / networkName / "impact_cache.csv", fingerprint,
+                     siteCodes);
+}
+
+vector<double> Data::getDeliverySiteDemands() const {
+    vector<double> demands;
+    demands.reserve(deliverySites.size());
+    for(const auto &pair : deliverySiteOrder) demands.push_back(pair.second->getDemand());
+    return demands;
+}
+
+vector<double> Data::getDeliverySiteFlows() const {
+    vector<double> flows;
+    flows.reserve(deliverySites.size());
+    for(const auto &pair : deliverySiteOrder) flows.push_back(g.findVertex(pair.second->getVertexId())->getFlow());
+    return flows;
+}
+
+ImpactMatrix Data::impactMatrix(const vector<string> &codes, const vector<FailureResult> &results) const {
+    vector<string> siteCodes;
+    siteCodes.reserve(deliverySites.size());
+    for(const auto &pair : deliverySiteOrder) siteCodes.push_back(pair.first);
+    return {codes, siteCodes, getDeliverySiteFlows(), results};
+}
+
+void Data::printImpactSummary(const ImpactMatrix &matrix) const {
+    vector<WorstCase> worst = matrix.getWorstCases();
+
+    cout << "> Worst failure for each city: " << endl;
+    cout << setw(10) << left << "City Code" << " " << setw(10) << left << "Lost Flow" << " " << "Failure" << endl << endl;
+    for(size_t c = 0; c < matrix.getNumSites(); c++) {
+        if(worst[c].component == UINT32_MAX) continue;
+
+        cout << setw(10) << left << matrix.getSite(c) << " ";
+        cout << setw(10) << left << fixed << setprecision(0) << worst[c].loss << " ";
+        cout << matrix.getComponent(worst[c].component) << endl;
+    }
+    cout << endl;
+
+    // Failures sorted by the water they lose, the first one wins ties
+    vector<double> loss = matrix.getTotalLoss();
+    vector<size_t> order(loss.size());
+    for(size_t k = 0; k < order.size(); k++) order[k] = k;
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return loss[a] > loss[b]; });
+
+    const size_t numWorst = 5;
+    cout << "> Failures that lose the most water: " << endl;
+    cout << setw(10) << left << "Lost Flow" << " " << "Failure" << endl << endl;
+    for(size_t i = 0; i < min(numWorst, order.size()) && loss[order[i]] > 0; i++) {
+        cout << setw(10) << left << fixed << setprecision(0) << loss[order[i]] << " " << matrix.getComponent(order[i]) << endl;
+    }
+    cout << endl;
+}
+
+vector<FailureResult> Data::stationFailures(const vector<string> &codes, ScreeningStats &stats) {
+    vector<FailureResult> results(codes.size());
+    vector<size_t> missing;
+
+    for(size_t i = 0; i < codes.size(); i++) {
+        if(!impactCache.find(codes[i], results[i])) missing.push_back(i);
+    }
+    stats.components += codes.size();
+    stats.cached += codes.size() - missing.size();
+    if(missing.empty()) return results;
+
+    FailureSweep sweep(&g, getDeliverySiteIds(), numThreads);
+    const FailureAnalyzer &analyzer = sweep.getAnalyzer();
+    FailureResult baseline = sweep.getBaseline();
+
+    vector<FailureCase> cases;
+    vector<size_t> caseStation;
+
+    for(size_t i : missing) {
+        uint32_t id = g.findVertexId(codes[i]);
+
+        if(analyzer.getVertexFlow(id) <= 0) {
+            results[i] = baseline;
+            stats.noFlow++;
+            continue;
+        }
+        caseStation.push_back(i);
+        cases.push_back(FailureCase::station(id));
+    }
+
+    vector<FailureResult> caseResults = sweep.run(cases);
+    stats.solved += cases.size();
+
+    for(size_t c = 0; c < cases.size(); c++) results[caseStation[c]] = std::move(caseResults[c]);
+
+    for(size_t i : missing) impactCache.insert(codes[i], results[i]);
+    impactCache.save();
+    return results;
+}
+
+vector<FailureResult> Data::pipelineFailures(const vector<string> &codes, ScreeningStats &stats) {
+    vector<FailureResult> results(codes.size());
+    vector<size_t> missing;
+
+    for(size_t i = 0; i < codes.size(); i++) {
+        if(!impactCache.find(codes[i], results[i])) missing.push_back(i);
+    }
+    stats.components += codes.size();
+    stats.cached += codes.size() - missing.size();
+    if(missing.empty()) return results;
+
+    FailureSweep sweep(&g, getDeliverySiteIds(), numThreads);
+    const FailureAnalyzer &analyzer = sweep.getAnalyzer();
+    FailureResult baseline = sweep.getBaseline();
+
+    vector<FailureCase> cases;
+    vector<size_t> casePipeline;
+
+    for(size_t i : missing) {
+        Pipe pipeline = pipes.get(pipes.find(codes[i]));
+        uint32_t vertexA = pipeline.getVertexA();
+        uint32_t vertexB = pipeline.getVertexB();
+        bool unidirectional = pipeline.getUnidirectional();
+
+        PipelineFailure failure = analyzer.classifyPipeline(vertexA, vertexB, unidirectional);
+
+        // Without flow or with a bypass, every delivery site keeps its baseline flow
+        if(failure == PipelineFailure::NoFlow || failure == PipelineFailure::Bypass) {
+            results[i] = baseline;
+            if(failure == PipelineFailure::NoFlow) stats.noFlow++;
+            else stats.bypassed++;
+            continue;
+        }
+        if(failure == PipelineFailure::CutEdge) stats.bounded++;
+        else stats.solved++;
+
+        casePipeline.push_back(i);
+        cases.push_back(FailureCase::pipeline(vertexA, vertexB, unidirectional, failure == PipelineFailure::Reroute));
+    }
+
+    vector<FailureResult> caseResults = sweep.run(cases);
+
+    for(size_t c = 0; c < cases.size(); c++) results[casePipeline[c]] = std::move(caseResults[c]);
+
+    for(size_t i : missing) impactCache.insert(codes[i], results[i]);
+    impactCache.save();
+    return results;
+}
+
+vector<bool> Data::essentialStations(const vector<string> &codes, ScreeningStats &stats) {
+    double maxFlow = metrics.getMaxFlow();
+    vector<bool> essential(codes.size(), false);
+
+    vector<string> undecided;
+    vector<size_t> undecidedIndex;
+
+    FailureAnalyzer analyzer(&g);
+
+    for(size_t i = 0; i < codes.size(); i++) {
+        if(analyzer.stationLossBound(g.findVertexId(codes[i])) > 0) {
+            essential[i] = true;
+            stats.components++;
+            stats.bounded++;
+            continue;
+        }
+        undecided.push_back(codes[i]);
+        undecidedIndex.push_back(i);
+    }
+
+    vector<FailureResult> results = stationFailures(undecided, stats);
+
+    for(size_t u = 0; u < undecided.size(); u++) {
+        essential[undecidedIndex[u]] = results[u].maxFlow != maxFlow;
+    }
+    return essential;
+}
+
+void Data::printScreeningStats(const ScreeningStats &stats) const {
+    cout << "Failures: " << stats.components << " | Solved: " << stats.solved << " | Solves skipped: "
+         << stats.components - stats.solved << endl;
+    cout << "(Cached: " << stats.cached << ", No flow: " << stats.noFlow << ", Bypassed: " << stats.bypassed
+         << ", Min cut: " << stats.bounded << ")" << endl << endl;
+}
+
+// Smallest byte range of a pipes file parsed by one task, and ranges per thread so the tasks stay balanced
+static constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+// Runs task(0) to task(numTasks - 1) on up to numThreads threads, and rethrows the first exception of a task
+static void runTasks(size_t numTasks, unsigned int numThreads, const function<void(size_t)> &task) {
+    atomic<size_t> next(0);
+    exception_ptr error = nullptr;
+    mutex errorMutex;
+
+    auto work = [&]() {
+        for(size_t i = next++; i < numTasks; i = next++) {
+            try {
+                task(i);
+            }
+            catch(...) {
+                lock_guard<mutex> lock(errorMutex);
+                if(error == nullptr) error = current_exception();
+                next = numTasks;
+            }
+        }
+    };
+
+    size_t numWorkers = min<size_t>(numThreads, numTasks);
+
+    if(numWorkers <= 1) {
+        work();
+    }
+    else {
+        vector<thread> threads;
+        threads.reserve(numWorkers);
+        for(size_t w = 0; w < numWorkers; w++) threads.emplace_back(work);
+        for(thread &t : threads) t.join();
+    }
+
+    if(error != nullptr) rethrow_exception(error);
+}
+
+// Number k of a 'Pipes_part<k>' shard, or 0 if the file name has none
+static uint64_t getPartNumber(const filesystem::path &path) {
+    string filename = path.filename().string();
+    size_t pos = filename.find("_part");
+    uint64_t part = 0;
+    if(pos != string::npos) from_chars(filename.data() + pos + 5, filename.data() + filename.size(), part);
+    return part;
+}
+
 void Data::readFiles(const filesystem::path &dir_path) {
     filesystem::path reservoirPath;
     filesystem::path stationsPath;
     filesystem::path citiesPath;
-    filesystem::path pipesPath;
+    vector<filesystem::path> pipesPaths;
 
     try {
         for (const auto& entry : filesystem::directory_iterator(dir_path)) {
@@ -35,148 +315,445 @@ void Data::readFiles(const filesystem::path &dir_path) {
                     citiesPath = dir_path / filename;
 
                 } else if (filename.find("Pipes") != string::npos) {
-                    if (!pipesPath.empty()) throw runtime_error("Error: Multiple Pipes files found.");
+                    pipesPaths.push_back(dir_path / filename);
+                }
+            }
+        }
 
-                    pipesPath = dir_path / filename;
+        if(reservoirPath.empty() | stationsPath.empty() | citiesPath.empty() | pipesPaths.empty()) throw runtime_error("Invalid input. Some file are missing in the given path.");
+
+        // Several pipes files are only allowed as the shards of one file, read in the order of their part numbers
+        if(pipesPaths.size() > 1) {
+            for(const filesystem::path &path : pipesPaths) {
+                if(path.filename().string().find("Pipes_part") == string::npos) {
+                    throw runtime_error("Error: Multiple Pipes files found.");
                 }
             }
+            sort(pipesPaths.begin(), pipesPaths.end(), [](const filesystem::path &a, const filesystem::path &b) {
+                uint64_t partA = getPartNumber(a), partB = getPartNumber(b);
+                return partA != partB ? partA < partB : a.filename() < b.filename();
+            });
         }
 
-        if(reservoirPath.empty() | stationsPath.empty() | citiesPath.empty() | pipesPath.empty()) throw runtime_error("Invalid input. Some file are missing in the given path.");
+        CsvReader reservoirFile;
+        CsvReader stationsFile;
+        CsvReader citiesFile;
+        vector<CsvReader> pipesFiles(pipesPaths.size());
 
-        ifstream reservoirFile(reservoirPath);
-        ifstream stationsFile(stationsPath);
-        ifstream citiesFile(citiesPath);
-        ifstream pipesFile(pipesPath);
+        if (!reservoirFile.open(reservoirPath)) throw runtime_error("Error opening the reservoir file.");
+        if (!stationsFile.open(stationsPath)) throw runtime_error("Error opening the stations file.");
+        if (!citiesFile.open(citiesPath)) throw runtime_error("Error opening the cities file.");
+        for(size_t i = 0; i < pipesFiles.size(); i++) {
+            if (!pipesFiles[i].open(pipesPaths[i])) throw runtime_error("Error opening the pipes file.");
+        }
 
-        if (!reservoirFile.is_open()) throw runtime_error("Error opening the reservoir file.");
-        if (!stationsFile.is_open()) throw runtime_error("Error opening the stations file.");
-        if (!citiesFile.is_open()) throw runtime_error("Error opening the cities file.");
-        if (!pipesFile.is_open()) throw runtime_error("Error opening the pipes file.");
+        unsigned int threads = numThreads != 0 ? numThreads : max(1u, thread::hardware_concurrency());
+
+        // The files are already mapped, so they are hashed without reading them again, before quoted fields are
+        // unescaped in place. A sharded pipes file is hashed as the sequence of the hashes of its shards.
+        size_t numFiles = 3 + pipesFiles.size();
+        vector<uint64_t> hashes(numFiles);
+        runTasks(numFiles, threads, [&](size_t i) {
+            const CsvReader &file = i == 0 ? reservoirFile : i == 1 ? stationsFile
+                                  : i == 2 ? citiesFile : pipesFiles[i - 3];
+            hashes[i] = ImpactCache::hash(file.data(), file.size());
+        });
+        uint64_t pipesHash = hashes[3];
+        if(pipesFiles.size() > 1) {
+            size_t shardHashesSize = pipesFiles.size() * sizeof(uint64_t);
+            pipesHash = ImpactCache::hash(reinterpret_cast<const char *>(&hashes[3]), shardHashesSize);
+        }
+        uint64_t fileHashes[] = {hashes[0], hashes[1], hashes[2], pipesHash};
+
+        // The pipes files are split into ranges of whole rows, large files into several ranges
+        vector<size_t> rangeFiles;
+        vector<pair<size_t, size_t>> ranges;
+        vector<string_view> header;
+        for(size_t i = 0; i < pipesFiles.size(); i++) {
+            pipesFiles[i].nextRow(header);
+            size_t numChunks = min<size_t>(threads * CHUNKS_PER_THREAD, pipesFiles[i].size() / MIN_CHUNK_BYTES);
+            numChunks = max<size_t>(numChunks, 1);
+            for(const auto &range : pipesFiles[i].splitRows(numChunks)) {
+                rangeFiles.push_back(i);
+                ranges.push_back(range);
+            }
+        }
 
-        readFileReservoir(reservoirFile);
-        readFileStations(stationsFile);
-        readFileCities(citiesFile);
-        readFilePipes(pipesFile);
+        // The entity files are parsed at the same time
+        vector<ReservoirRow> reservoirRows;
+        vector<StationRow> stationRows;
+        vector<CityRow> cityRows;
+        runTasks(3, threads, [&](size_t i) {
+            if(i == 0) parseReservoirs(reservoirFile, reservoirRows);
+            else if(i == 1) parseStations(stationsFile, stationRows);
+            else parseCities(citiesFile, cityRows);
+        });
+
+        // The vertices are added in file order, so their ids do not depend on how the files were parsed
+        addReservoirs(reservoirRows);
+        addStations(stationRows);
+        addCities(cityRows);
+        recordEntityOrder();
+
+        // Every range of the pipes files is parsed at the same time, straight into packed records, and the files are
+        // unmapped before the graph is built
+        vector<PipeChunk> pipeChunks(ranges.size());
+        runTasks(ranges.size(), threads, [&](size_t i) {
+            parsePipes(pipesFiles[rangeFiles[i]], ranges[i], pipeChunks[i]);
+        });
+        for(CsvReader &file : pipesFiles) file.close();
+        addPipes(pipeChunks);
 
         networkName = dir_path.stem();
 
         g.maxFlow(&waterReservoirs, &deliverySites);
-        metrics = g.calculateMetrics(&deliverySites);
+        metrics = g.calculateMetrics();
+
+        inputsFingerprint = ImpactCache::hash(reinterpret_cast<const char *>(fileHashes), sizeof(fileHashes));
+        openImpactCache();
+
+        vector<uint32_t> reservoirIds;
+        for(const auto &pair : reservoirOrder) reservoirIds.push_back(pair.second->getVertexId());
+        minCutTable.reset(&g, reservoirIds, getDeliverySiteIds(), numThreads);
     } catch (const exception& e) {
         throw;
     }
 }
 
-void Data::readFileReservoir(ifstream &file) {
-    string line;
-    getline(file,line);
+void Data::saveNetworkSnapshot() {
+    filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
+    string filename = networkName + NetworkSnapshot::EXTENSION;
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+
+    if(saveSnapshot(dir_path / filename)) {
+        cout << ">> Snapshot is at: ./output/" << networkName << "/" << filename << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the snapshot file." << endl;
+        cout << "\033[0m";
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+}
 
-    while(getline(file,line)) {
-        // Remove carriage return characters if present
-        line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+bool Data::saveSnapshot(const filesystem::path &path) {
+    SnapshotContents contents;
+    SnapshotHeader &header = contents.header;
+
+    header.networkName = contents.addString(networkName);
+    header.inputsFingerprint = inputsFingerprint;
+    header.solverName = contents.addString(g.getMaxFlowSolver()->getName());
+    header.mainSource = g.getMainSourceId();
+    header.mainTarget = g.getMainTargetId();
+
+    double values[] = {metrics.getAbsoluteAverage(), metrics.getAbsoluteVariance(),
+                       metrics.getAbsoluteStandardDeviation(), metrics.getAbsoluteMaxDifference(),
+                       metrics.getRelativeAverage(), metrics.getRelativeVariance(),
+                       metrics.getRelativeStandardDeviation(), metrics.getRelativeMaxDifference(),
+                       metrics.getMaxFlow(), metrics.getTotalDemand()};
+    copy(begin(values), end(values), header.metrics);
+
+    for(Vertex *v : g.getVertexSet()) {
+        contents.vertices.push_back({contents.addString(v->getCode()), (uint32_t) v->getType(), v->getFlow()});
+    }
 
-        string reservoir, municipality, code;
-        double id, maxDelivery;
-        stringstream ss(line);
-        getline(ss,reservoir,',');
-        getline(ss,municipality,',');
-        ss >> id;
-        ss.ignore();
-        getline(ss, code,',');
-        ss >> maxDelivery;
-        ss.ignore();
+    // Edges in creation order, with the reverse edges as positions in that order
+    // The positions are found in a sorted vector, which takes a fraction of the memory of a hash map of every edge
+    auto byEdge = [](const pair<const Edge *, uint32_t> &a, const pair<const Edge *, uint32_t> &b) {
+        return less<const Edge *>()(a.first, b.first);
+    };
+    vector<pair<const Edge *, uint32_t>> edgeIndex(g.getNumEdges());
+    for(size_t i = 0; i < g.getNumEdges(); i++) edgeIndex[i] = {g.getEdge(i), (uint32_t) i};
+    sort(edgeIndex.begin(), edgeIndex.end(), byEdge);
+
+    for(size_t i = 0; i < g.getNumEdges(); i++) {
+        Edge *e = g.getEdge(i);
+        uint32_t reverse = NetworkSnapshot::NO_EDGE;
+        if(e->getReverse() != nullptr) {
+            pair<const Edge *, uint32_t> key(e->getReverse(), 0);
+            reverse = lower_bound(edgeIndex.begin(), edgeIndex.end(), key, byEdge)->second;
+        }
+        contents.edges.push_back({e->getOrig()->getId(), e->getDest()->getId(), reverse, 0, e->getCapacity(),
+                                  e->getFlow()});
+    }
 
-        if(reservoir.empty() | municipality.empty() | code.empty()) continue;
+    // Entities in the order the reports visit them
+    for(auto &pair : reservoirOrder) {
+        WaterReservoir *wr = pair.second;
+        contents.reservoirs.push_back({contents.addString(wr->getName()), contents.addString(wr->getMunicipality()),
+                                       contents.addString(pair.first), wr->getVertexId(), wr->getId(),
+                                       wr->getMaxDelivery()});
+    }
+    for(auto &pair : stationOrder) {
+        PumpingStation *ps = pair.second;
+        contents.stations.push_back({contents.addString(pair.first), ps->getVertexId(), ps->getId()});
+    }
+    for(auto &pair : deliverySiteOrder) {
+        DeliverySite *ds = pair.second;
+        contents.cities.push_back({contents.addString(ds->getCity()), contents.addString(pair.first),
+                                   ds->getVertexId(), 0, ds->getId(), ds->getDemand(), ds->getPopulation()});
+    }
+    // Pipes in file order. Their codes are the codes of their vertices, so they are only stored for the pipes with a
+    // missing service point, instead of one string per pipe
+    uint32_t noCode = contents.addString("");
+    for(uint32_t i = 0; i < pipes.size(); i++) {
+        Pipe p = pipes.get(i);
+        bool known = p.getVertexA() != NO_VERTEX && p.getVertexB() != NO_VERTEX;
+        contents.pipes.push_back({known ? noCode : contents.addString(pipes.getCode(i)),
+                                  contents.addString(p.getServicePointA()), contents.addString(p.getServicePointB()),
+                                  p.getVertexA(), p.getVertexB(), p.getUnidirectional(), p.getCapacity()});
+    }
 
-        auto* wr = new WaterReservoir(reservoir, municipality, id, code, maxDelivery);
-        g.addVertex(code, VertexType::WaterReservoir);
-        this->waterReservoirs.insert({code, wr});
+    // The pairs not queried yet are only solved here, so a loaded snapshot answers every pair without a max flow
+    minCutTable.fill();
+    contents.cutSources = minCutTable.getSources();
+    contents.cutSinks = minCutTable.getSinks();
+    for(const vector<PairCut> &row : minCutTable.getRows()) {
+        for(const PairCut &cut : row) {
+            contents.cuts.push_back({cut.maxFlow, (uint32_t) contents.cutEdges.size(), (uint32_t) cut.edges.size()});
+            for(const auto &edge : cut.edges) contents.cutEdges.push_back({edge.first, edge.second});
+        }
     }
+
+    return NetworkSnapshot::save(path, contents);
 }
 
-void Data::readFileStations(ifstream &file) {
-    string line;
-    getline(file,line);
+void Data::readSnapshot(const filesystem::path &path) {
+    NetworkSnapshot snapshot;
+    snapshot.open(path);
+    const SnapshotHeader &header = snapshot.getHeader();
+
+    // The graph is rebuilt as it was saved: the vertices in id order, then the edges in creation order
+    const auto *vertices = snapshot.getRecords<SnapshotVertex>(header.vertices);
+    for(uint64_t i = 0; i < header.vertices.count; i++) {
+        uint32_t id = g.addVertex(string(snapshot.getString(vertices[i].code)), (VertexType) vertices[i].type);
+        if(id != i) throw runtime_error("Invalid network snapshot: duplicated vertex code.");
+        g.findVertex(id)->setFlow(vertices[i].flow);
+    }
 
-    while(getline(file,line)) {
-        // Remove carriage return characters if present
-        line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+    const auto *edgeRecords = snapshot.getRecords<SnapshotEdge>(header.edges);
+    vector<Edge *> edges(header.edges.count);
+    for(uint64_t i = 0; i < header.edges.count; i++) {
+        const SnapshotEdge &e = edgeRecords[i];
+        edges[i] = g.addUnpairedEdge(e.orig, e.dest, e.capacity, e.flow);
+    }
+    for(uint64_t i = 0; i < header.edges.count; i++) {
+        if(edgeRecords[i].reverse != NetworkSnapshot::NO_EDGE) edges[i]->setReverse(edges[edgeRecords[i].reverse]);
+    }
+    g.setMainVertices(header.mainSource, header.mainTarget);
+
+    // The records are in the order the reports visit the entities, so they give back that order
+    const auto *reservoirs = snapshot.getRecords<SnapshotReservoir>(header.reservoirs);
+    reservoirOrder.reserve(header.reservoirs.count);
+    for(uint64_t i = 0; i < header.reservoirs.count; i++) {
+        const SnapshotReservoir &r = reservoirs[i];
+        string code(snapshot.getString(r.code));
+        auto *wr = new WaterReservoir(string(snapshot.getString(r.name)), string(snapshot.getString(r.municipality)),
+                                      r.id, code, r.vertex, r.maxDelivery);
+        if(!waterReservoirs.insert({code, wr}).second) delete wr;
+        else reservoirOrder.emplace_back(code, wr);
+    }
 
-        string code;
-        double id;
-        stringstream ss(line);
-        ss >> id;
-        ss.ignore();
-        getline(ss, code,',');
+    const auto *stations = snapshot.getRecords<SnapshotStation>(header.stations);
+    stationOrder.reserve(header.stations.count);
+    for(uint64_t i = 0; i < header.stations.count; i++) {
+        string code(snapshot.getString(stations[i].code));
+        auto *ps = new PumpingStation(stations[i].id, code, stations[i].vertex);
+        if(!pumpingStations.insert({code, ps}).second) delete ps;
+        else stationOrder.emplace_back(code, ps);
+    }
 
-        if(code.empty()) continue;
+    const auto *cities = snapshot.getRecords<SnapshotCity>(header.cities);
+    deliverySiteOrder.reserve(header.cities.count);
+    for(uint64_t i = 0; i < header.cities.count; i++) {
+        const SnapshotCity &c = cities[i];
+        string code(snapshot.getString(c.code));
+        auto *ds = new DeliverySite(string(snapshot.getString(c.city)), c.id, code, c.vertex, c.demand, c.population);
+        if(!deliverySites.insert({code, ds}).second) delete ds;
+        else deliverySiteOrder.emplace_back(code, ds);
+    }
 
-        auto* ps = new PumpingStation(id, code);
-        g.addVertex(code, VertexType::PumpingStation);
-        this->pumpingStations.insert({code, ps});
+    // The pipes are added in file order, their edges are already in the graph
+    const auto *pipeRecords = snapshot.getRecords<SnapshotPipe>(header.pipes);
+    pipes.reserve(header.pipes.count);
+    for(uint64_t i = 0; i < header.pipes.count; i++) {
+        const SnapshotPipe &p = pipeRecords[i];
+        if(p.vertexA != NO_VERTEX && p.vertexB != NO_VERTEX) {
+            pipes.add(p.vertexA, p.vertexB, p.capacity, p.unidirectional != 0);
+        }
+        else {
+            pipes.add(string(snapshot.getString(p.servicePointA)), string(snapshot.getString(p.servicePointB)),
+                      p.vertexA, p.vertexB, p.capacity, p.unidirectional != 0);
+        }
+    }
+
+    const double *m = header.metrics;
+    metrics = GraphMetrics(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9]);
+    networkName = string(snapshot.getString(header.networkName));
+    inputsFingerprint = header.inputsFingerprint;
+
+    const auto *cutSources = snapshot.getRecords<uint32_t>(header.cutSources);
+    const auto *cutSinks = snapshot.getRecords<uint32_t>(header.cutSinks);
+    const auto *cutRecords = snapshot.getRecords<SnapshotPairCut>(header.cuts);
+    const auto *cutEdges = snapshot.getRecords<SnapshotCutEdge>(header.cutEdges);
+    vector<PairCut> cuts(header.cuts.count);
+    for(uint64_t i = 0; i < header.cuts.count; i++) {
+        cuts[i].maxFlow = cutRecords[i].maxFlow;
+        for(uint32_t k = 0; k < cutRecords[i].numEdges; k++) {
+            const SnapshotCutEdge &edge = cutEdges[cutRecords[i].firstEdge + k];
+            cuts[i].edges.emplace_back(edge.orig, edge.dest);
+        }
+    }
+    minCutTable.restore(&g, vector<uint32_t>(cutSources, cutSources + header.cutSources.count),
+                        vector<uint32_t>(cutSinks, cutSinks + header.cutSinks.count), std::move(cuts), numThreads);
+
+    // The baseline max flow depends on the solver, so it is only reused when the snapshot was saved with this one
+    if(snapshot.getString(header.solverName) != g.getMaxFlowSolver()->getName()) {
+        g.setAllEdgesFlow(0);
+        g.setAllVerticesFlow(0);
+        g.runMaxFlow();
+        metrics = g.calculateMetrics();
     }
+    openImpactCache();
 }
 
-void Data::readFileCities(ifstream &file) {
-    string line;
-    getline(file,line);
+// Field of a row, or an empty field if the row is shorter
+static string_view getField(const vector<string_view> &fields, size_t i) {
+    return i < fields.size() ? fields[i] : string_view();
+}
 
-    while(getline(file,line)) {
-        // Remove carriage return characters if present
-        line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+void Data::parseReservoirs(CsvReader &file, vector<ReservoirRow> &rows) {
+    vector<string_view> fields;
+    file.nextRow(fields);
 
-        string city, code;
-        double id, demand, population;
-        stringstream ss(line);
-        getline(ss, city,',');
-        ss >> id;
-        ss.ignore();
-        getline(ss, code,',');
-        ss >> demand;
-        ss.ignore();
-        ss >> population;
-        ss.ignore();
+    while(file.nextRow(fields)) {
+        ReservoirRow row;
+        row.name = getField(fields, 0);
+        row.municipality = getField(fields, 1);
+        row.code = getField(fields, 3);
+        CsvReader::parseNumber(getField(fields, 2), row.id);
+        CsvReader::parseNumber(getField(fields, 4), row.maxDelivery);
 
-        if(code.empty() || city.empty()) continue;
+        if(row.name.empty() | row.municipality.empty() | row.code.empty()) continue;
+        rows.push_back(row);
+    }
+}
+
+void Data::parseStations(CsvReader &file, vector<StationRow> &rows) {
+    vector<string_view> fields;
+    file.nextRow(fields);
+
+    while(file.nextRow(fields)) {
+        StationRow row;
+        row.code = getField(fields, 1);
+        CsvReader::parseNumber(getField(fields, 0), row.id);
 
-        auto* ds = new DeliverySite(city, id, code, demand, population);
-        g.addVertex(code, VertexType::DeliverySite);
-        this->deliverySites.insert({code, ds});
+        if(row.code.empty()) continue;
+        rows.push_back(row);
     }
 }
 
-void Data::readFilePipes(ifstream &file) {
-    string line;
-    getline(file,line);
+void Data::parseCities(CsvReader &file, vector<CityRow> &rows) {
+    vector<string_view> fields;
+    file.nextRow(fields);
 
-    while(getline(file,line)) {
-        // Remove carriage return characters if present
-        line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+    while(file.nextRow(fields)) {
+        CityRow row;
+        row.name = getField(fields, 0);
+        row.code = getField(fields, 2);
+        CsvReader::parseNumber(getField(fields, 1), row.id);
+        CsvReader::parseNumber(getField(fields, 3), row.demand);
+        CsvReader::parseNumber(getField(fields, 4), row.population);
+
+        if(row.code.empty() || row.name.empty()) continue;
+        rows.push_back(row);
+    }
+}
 
-        string servicePointA, servicePointB;
+void Data::parsePipes(CsvReader &file, pair<size_t, size_t> range, PipeChunk &chunk) const {
+    vector<string_view> fields;
+    size_t offset = range.first;
+    string servicePointA, servicePointB;
+
+    while(file.nextRow(offset, range.second, fields)) {
         double capacity, direction;
-        stringstream ss(line);
-        getline(ss, servicePointA,',');
-        getline(ss, servicePointB,',');
-        ss >> capacity;
-        ss.ignore();
-        ss >> direction;
-        ss.ignore();
+        CsvReader::parseNumber(getField(fields, 2), capacity);
+        CsvReader::parseNumber(getField(fields, 3), direction);
+
+        if(getField(fields, 0).empty() || getField(fields, 1).empty()) continue;
+
+        servicePointA.assign(fields[0]);
+        servicePointB.assign(fields[1]);
+
+        // Resolve the service point codes only once, the rest of the program works with their ids
+        uint32_t vertexA = g.findVertexId(servicePointA);
+        uint32_t vertexB = g.findVertexId(servicePointB);
+        chunk.pipes.push_back({vertexA, vertexB, capacity, direction != 1});
+        if(vertexA == NO_VERTEX || vertexB == NO_VERTEX) chunk.unknownCodes.emplace_back(servicePointA, servicePointB);
+    }
+}
 
-        if(servicePointA.empty() || servicePointB.empty()) continue;
+void Data::addReservoirs(const vector<ReservoirRow> &rows) {
+    for(const ReservoirRow &row : rows) {
+        string reservoirCode(row.code);
+        uint32_t vertexId = g.addVertex(reservoirCode, VertexType::WaterReservoir);
+        auto* wr = new WaterReservoir(string(row.name), string(row.municipality), row.id, reservoirCode, vertexId,
+                                      row.maxDelivery);
+        if(!this->waterReservoirs.insert({reservoirCode, wr}).second) delete wr;   // duplicated code, the first is kept
+    }
+}
 
-        bool unidirectional = direction == 1;
+void Data::addStations(const vector<StationRow> &rows) {
+    for(const StationRow &row : rows) {
+        string stationCode(row.code);
+        uint32_t vertexId = g.addVertex(stationCode, VertexType::PumpingStation);
+        auto* ps = new PumpingStation(row.id, stationCode, vertexId);
+        if(!this->pumpingStations.insert({stationCode, ps}).second) delete ps;   // duplicated code, the first is kept
+    }
+}
 
-        Pipe* pipe = new Pipe(servicePointA, servicePointB, capacity, unidirectional);
-        string key = servicePointA;
-        key += "-";
-        key += servicePointB;
-        this->pipes.insert({key, pipe});
+void Data::addCities(const vector<CityRow> &rows) {
+    for(const CityRow &row : rows) {
+        string cityCode(row.code);
+        uint32_t vertexId = g.addVertex(cityCode, VertexType::DeliverySite);
+        auto* ds = new DeliverySite(string(row.name), row.id, cityCode, vertexId, row.demand, row.population);
+        if(!this->deliverySites.insert({cityCode, ds}).second) delete ds;   // duplicated code, the first one is kept
+    }
+}
 
-        if(unidirectional) g.addEdge(servicePointA, servicePointB, capacity);
-        else g.addBidirectionalEdge(servicePointA, servicePointB, capacity);
+void Data::recordEntityOrder() {
+    reservoirOrder.assign(waterReservoirs.begin(), waterReservoirs.end());
+    stationOrder.assign(pumpingStations.begin(), pumpingStations.end());
+    deliverySiteOrder.assign(deliverySites.begin(), deliverySites.end());
+}
+
+void Data::addPipes(vector<PipeChunk> &chunks) {
+    size_t numRows = 0;
+    for(const PipeChunk &chunk : chunks) numRows += chunk.pipes.size();
+    pipes.reserve(numRows);
+
+    for(PipeChunk &chunk : chunks) {
+        size_t unknown = 0;
+        for(const EdgeSpec &pipe : chunk.pipes) {
+            if(pipe.source != NO_VERTEX && pipe.dest != NO_VERTEX) {
+                pipes.add(pipe.source, pipe.dest, pipe.capacity, !pipe.bidirectional);
+            }
+            else {
+                auto &codes = chunk.unknownCodes[unknown++];
+                pipes.add(std::move(codes.first), std::move(codes.second), pipe.source, pipe.dest, pipe.capacity,
+                          !pipe.bidirectional);
+            }
+        }
+        chunk = PipeChunk();
     }
+
+    g.addEdges(pipes.getEdges());
 }
 
 // Confirm Existence
@@ -200,15 +777,15 @@ bool Data::pumpingStationExists(const string &code) {
 }
 
 bool Data::pipelineExists(const string &code) {
-    auto it = pipes.find(code);
-    if (it != pipes.end()) return true;
+    uint32_t pipe = pipes.find(code);
+    if (pipe != PipeTable::NO_PIPE) return true;
     size_t dashPos = code.find('-');
     if (dashPos != string::npos) {
         string serviceStationA = code.substr(0, dashPos);
         string serviceStationB = code.substr(dashPos + 1);
 
-        it = pipes.find(serviceStationB+"-"+serviceStationA);
-        if (it != pipes.end() && !(*it).second->getUnidirectional()) return true;
+        pipe = pipes.find(serviceStationB+"-"+serviceStationA);
+        if (pipe != PipeTable::NO_PIPE && !pipes.get(pipe).getUnidirectional()) return true;
     }
     return false;
 }
@@ -223,7 +800,7 @@ void Data::cityMaxFlow(const string &code) {
 
     string cityName = ds->getCity();
     double demand = ds->getDemand();
-    double flow = g.findVertex(code)->getFlow();
+    double flow = g.findVertex(ds->getVertexId())->getFlow();
 
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
@@ -238,6 +815,97 @@ void Data::cityMaxFlow(const string &code) {
     cout << "\033[0m";
 }
 
+void Data::reservoirCityMaxFlow(const string &reservoirCode, const string &cityCode) {
+    WaterReservoir *wr = waterReservoirs[reservoirCode];
+    DeliverySite *ds = deliverySites[cityCode];
+
+    const PairCut *cut = minCutTable.find(wr->getVertexId(), ds->getVertexId());
+    uint32_t mainSource = g.getMainSourceId();
+    uint32_t mainTarget = g.getMainTargetId();
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+    cout << ">> Reservoir to City Max Flow: " << endl;
+    cout << "Reservoir: " << wr->getName() << " (" << reservoirCode << ")" << endl;
+    cout << "City: " << ds->getCity() << " (" << cityCode << ")" << endl;
+    cout << "Flow value: " << fixed << setprecision(0) << cut->maxFlow << " m3/sec" << endl << endl;
+
+    cout << "Minimum cut: " << endl;
+    for(const auto &edge : cut->edges) {
+        if(edge.first == mainSource) {
+            cout << "   Max delivery of " << reservoirCode;
+            cout << ": " << fixed << setprecision(0) << wr->getMaxDelivery() << " m3/sec" << endl;
+        }
+        else if(edge.second == mainTarget) {
+            cout << "   Demand of " << cityCode;
+            cout << ": " << fixed << setprecision(0) << ds->getDemand() << " m3/sec" << endl;
+        }
+        else {
+            Edge *e = g.findVertex(edge.first)->findEdge(g.findVertex(edge.second));
+            cout << "   Pipeline " << g.findVertex(edge.first)->getCode() << "-" << g.findVertex(edge.second)->getCode();
+            cout << ": " << fixed << setprecision(0) << e->getCapacity() << " m3/sec" << endl;
+        }
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+}
+
+void Data::maxDemandGrowth() {
+    DemandGrowth growth = g.maxDemandGrowth(1e-6);
+    double totalDemand = metrics.getTotalDemand();
+    uint32_t mainSource = g.getMainSourceId();
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+    cout << ">> Max Demand Growth: " << endl;
+    cout << "Total Demand: " << fixed << setprecision(0) << totalDemand << " m3/sec" << endl;
+    cout << "Growth factor: " << fixed << setprecision(4) << growth.factor << endl;
+    cout << "Total Demand at this factor: " << fixed << setprecision(0) << totalDemand * growth.factor << " m3/sec" << endl;
+    cout << "Solver runs: " << growth.iterations << endl << endl;
+
+    if(growth.factor >= 1) {
+        cout << "> Every city demand can grow by " << fixed << setprecision(2) << (growth.factor - 1) * 100;
+        cout << "% before the network stops meeting it!" << endl << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "> The network cannot meet the current demands! They must shrink to " << fixed << setprecision(2);
+        cout << growth.factor * 100 << "% to be met." << endl << endl;
+        cout << "\033[0m";
+    }
+
+    cout << "> Limiting cut: " << endl;
+    for(const auto &edge : growth.cut) {
+        Vertex *orig = g.findVertex(edge.first);
+        Vertex *dest = g.findVertex(edge.second);
+
+        if(edge.first == mainSource) {
+            cout << "   Max delivery of " << dest->getCode();
+            cout << ": " << fixed << setprecision(0) << waterReservoirs[dest->getCode()]->getMaxDelivery() << " m3/sec" << endl;
+        }
+        else {
+            cout << "   Pipeline " << orig->getCode() << "-" << dest->getCode();
+            cout << ": " << fixed << setprecision(0) << orig->findEdge(dest)->getCapacity() << " m3/sec" << endl;
+        }
+    }
+
+    cout << endl << "> Cities behind the cut: " << endl;
+    for(uint32_t site : growth.limitedSites) {
+        const string &cityCode = g.findVertex(site)->getCode();
+        DeliverySite *ds = deliverySites[cityCode];
+        cout << "   " << setw(24) << left << ds->getCity() << " " << setw(10) << left << cityCode;
+        cout << " " << fixed << setprecision(0) << ds->getDemand() << " m3/sec" << endl;
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+}
+
 void Data::allCitiesMaxFlow() {
     filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
 
@@ -262,13 +930,13 @@ void Data::allCitiesMaxFlow() {
 
     double maxFlow = metrics.getMaxFlow();
 
-    for(auto &pair : deliverySites) {
-        const string cityCode = pair.first;
+    for(auto &pair : deliverySiteOrder) {
+        const string &cityCode = pair.first;
         DeliverySite *ds = pair.second;
 
         string cityName = ds->getCity();
         double demand = ds->getDemand();
-        double flow = g.findVertex(cityCode)->getFlow();
+        double flow = g.findVertex(ds->getVertexId())->getFlow();
 
         cout << setw(24) << left << cityName << " ";
         cout << setw(10) << left << cityCode << " ";
@@ -321,13 +989,13 @@ void Data::verifyWaterSupply() {
     cout << setw(10) << left << "Code" << " ";
     cout << setw(11) << left << "Deficit Value" << endl << endl;
 
-    for(auto &pair : deliverySites) {
-        const string cityCode = pair.first;
+    for(auto &pair : deliverySiteOrder) {
+        const string &cityCode = pair.first;
         DeliverySite *ds = pair.second;
 
         string cityName = ds->getCity();
         double demand = ds->getDemand();
-        double flow = g.findVertex(cityCode)->getFlow();
+        double flow = g.findVertex(ds->getVertexId())->getFlow();
 
         if (demand <= flow) continue;
 
@@ -371,9 +1039,12 @@ void Data::verifyWaterSupply() {
 // Load Optimization
 
 void Data::loadOptimization() {
-    Graph *newGraph = g.copyGraph();
-    newGraph->optimizeLoad(&deliverySites);
-    GraphMetrics finalMetrics = newGraph->calculateMetrics(&deliverySites);
+    // Optimize the loaded network in place and put its max flow back afterwards
+    FlowSnapshot snapshot;
+    g.saveFlows(snapshot);
+    g.optimizeLoad();
+    GraphMetrics finalMetrics = g.calculateMetrics();
+    g.restoreFlows(snapshot);
 
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
@@ -413,8 +1084,6 @@ void Data::notEssentialReservoirs() {
 
     bool outputFileIsOpen = outputFile.is_open();
 
-    double maxFlow = metrics.getMaxFlow();
-
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
     cout << "\033[0m";
@@ -424,17 +1093,17 @@ void Data::notEssentialReservoirs() {
 
     unsigned int numNotEssentialReservoirs = 0;
 
-    Graph *newGraph = g.copyGraph();
-
-    for(auto &pair : waterReservoirs) {
-        string reservoirCode = pair.first;
+    vector<string> codes;
+    for(auto &pair : reservoirOrder) codes.push_back(pair.first);
 
-        newGraph->stationOutOfCommission(&reservoirCode);
+    ScreeningStats stats;
+    vector<bool> essential = essentialStations(codes, stats);
 
-        // Get current max flow
-        double totalWaterSupplied = newGraph->getTotalDemandAndMaxFlow(&deliverySites).second;
+    size_t i = 0;
+    for(auto &pair : reservoirOrder) {
+        const string &reservoirCode = pair.first;
 
-        if(totalWaterSupplied == maxFlow) {
+        if(!essential[i++]) {
             cout << setw(10) << "" << reservoirCode << endl;
             if(outputFileIsOpen) outputFile << reservoirCode << endl;
             numNotEssentialReservoirs++;
@@ -451,6 +1120,8 @@ void Data::notEssentialReservoirs() {
 
     cout << endl;
 
+    printScreeningStats(stats);
+
     if(outputFileIsOpen) {
         outputFile.close();
         cout << ">> Output file is at: ./output/" << networkName << "/not_essential_reservoirs.csv" << endl;
@@ -467,9 +1138,8 @@ void Data::notEssentialReservoirs() {
 }
 
 void Data::reservoirImpact(const string &code) {
-    Graph *newGraph = g.copyGraph();
-
-    newGraph->stationOutOfCommission(&code);
+    ScreeningStats stats;
+    FailureResult result = stationFailures({code}, stats)[0];
 
     auto it = waterReservoirs.find(code);
 
@@ -497,14 +1167,15 @@ void Data::reservoirImpact(const string &code) {
     cout << setw(10) << left << "Old Flow" << " ";
     cout << setw(10) << left << "New Flow" << endl << endl;
 
-    for(auto &pair : deliverySites) {
-        const string cityCode = pair.first;
+    size_t j = 0;
+    for(auto &pair : deliverySiteOrder) {
+        const string &cityCode = pair.first;
         DeliverySite *ds = pair.second;
 
         string cityName = ds->getCity();
         double demand = ds->getDemand();
-        double oldFlow = g.findVertex(cityCode)->getFlow();
-        double newFlow = newGraph->findVertex(cityCode)->getFlow();
+        double oldFlow = g.findVertex(ds->getVertexId())->getFlow();
+        double newFlow = result.flows[j++];
 
         totalWaterSupplied += newFlow;
 
@@ -563,24 +1234,29 @@ void Data::allReservoirsImpact() {
 
     if(outputFileIsOpen) outputFile << "Reservoir Code,City Code,Demand,Old Flow,New Flow" << endl;
 
-    Graph *newGraph = g.copyGraph();
+    vector<string> codes;
+    for(auto &pair : reservoirOrder) codes.push_back(pair.first);
 
-    for(auto &pair : waterReservoirs) {
-        string reservoirCode = pair.first;
+    ScreeningStats stats;
+    vector<FailureResult> results = stationFailures(codes, stats);
 
-        newGraph->stationOutOfCommission(&reservoirCode);
+    ImpactMatrix matrix = impactMatrix(codes, results);
+    vector<double> deltas = matrix.getDeltas();
+    vector<double> demands = getDeliverySiteDemands();
+    size_t n = matrix.getNumComponents();
 
-        cout << reservoirCode << "\t >  ";
+    for(size_t k = 0; k < n; k++) {
+        const string &reservoirCode = matrix.getComponent(k);
 
-        for(auto &dsPair : deliverySites) {
-            const string cityCode = dsPair.first;
-            DeliverySite *ds = dsPair.second;
+        cout << reservoirCode << "\t >  ";
 
-            double demand = ds->getDemand();
-            double oldFlow = g.findVertex(cityCode)->getFlow();
-            double newFlow = newGraph->findVertex(cityCode)->getFlow();
+        for(size_t c = 0; c < matrix.getNumSites(); c++) {
+            if (deltas[c * n + k] == 0) continue;
 
-            if (oldFlow == newFlow) continue;
+            const string &cityCode = matrix.getSite(c);
+            double demand = demands[c];
+            double oldFlow = matrix.getBaseline(c);
+            double newFlow = matrix.getFlow(k, c);
 
             cout << "(" << cityCode + ", ";
             cout << fixed << setprecision(0) << demand << ", ";
@@ -593,6 +1269,9 @@ void Data::allReservoirsImpact() {
     }
     cout << endl;
 
+    printImpactSummary(matrix);
+    printScreeningStats(stats);
+
     if(outputFileIsOpen) {
         outputFile.close();
         cout << ">> Output file is at: ./output/" << networkName << "/reservoirs_impact.csv" << endl;
@@ -603,6 +1282,15 @@ void Data::allReservoirsImpact() {
         cout << "\033[0m";
     }
 
+    if(matrix.save(dir_path / "reservoirs_impact.bin")) {
+        cout << ">> Impact matrix is at: ./output/" << networkName << "/reservoirs_impact.bin" << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the impact matrix file." << endl;
+        cout << "\033[0m";
+    }
+
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
     cout << "\033[0m";
@@ -620,8 +1308,6 @@ void Data::notEssentialPumpingStations() {
 
     bool outputFileIsOpen = outputFile.is_open();
 
-    double maxFlow = metrics.getMaxFlow();
-
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
     cout << "\033[0m";
@@ -631,17 +1317,17 @@ void Data::notEssentialPumpingStations() {
 
     unsigned int numNotEssentialPumpingStations = 0;
 
-    Graph *newGraph = g.copyGraph();
+    vector<string> codes;
+    for(auto &pair : stationOrder) codes.push_back(pair.first);
 
-    for(auto &pair : pumpingStations) {
-        string psCode = pair.first;
+    ScreeningStats stats;
+    vector<bool> essential = essentialStations(codes, stats);
 
-        newGraph->stationOutOfCommission(&psCode);
+    size_t i = 0;
+    for(auto &pair : stationOrder) {
+        const string &psCode = pair.first;
 
-        // Get current max flow
-        double totalWaterSupplied = newGraph->getTotalDemandAndMaxFlow(&deliverySites).second;
-
-        if(totalWaterSupplied == maxFlow) {
+        if(!essential[i++]) {
             cout << setw(10) << "" << psCode << endl;
             if(outputFileIsOpen) outputFile << psCode << endl;
             numNotEssentialPumpingStations++;
@@ -658,6 +1344,8 @@ void Data::notEssentialPumpingStations() {
 
     cout << endl;
 
+    printScreeningStats(stats);
+
     if(outputFileIsOpen) {
         outputFile.close();
         cout << ">> Output file is at: ./output/" << networkName << "/not_essential_stations.csv" << endl;
@@ -673,13 +1361,91 @@ void Data::notEssentialPumpingStations() {
     cout << "\033[0m";
 }
 
+void Data::singlePointsOfFailure() {
+    ResidualGraph rg(&g);
+    vector<uint32_t> idom;
+    dominatorTree(rg, idom);
+
+    filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
+
+    if (!filesystem::exists(dir_path))
+        filesystem::create_directory(dir_path);
+
+    ofstream outputFile(dir_path / "single_points_of_failure.csv");
+
+    bool outputFileIsOpen = outputFile.is_open();
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+    cout << ">> Single Points of Failure: " << endl;
+    cout << "(City Code, City Name) > Service Point Codes" << endl << endl;
+
+    if(outputFileIsOpen) outputFile << "City Code,City Name,Service Point Code" << endl;
+
+    unsigned int numDependentCities = 0;
+
+    for(auto &pair : deliverySiteOrder) {
+        const string &cityCode = pair.first;
+        DeliverySite *ds = pair.second;
+        uint32_t id = ds->getVertexId();
+
+        string cityName = ds->getCity();
+
+        cout << "(" << cityCode << ", " << cityName << ")  >  ";
+
+        if(idom[id] == NO_VERTEX) {
+            cout << "\033[31m" << "not supplied" << "\033[0m" << endl;
+            continue;
+        }
+
+        // Every vertex up the dominator tree, up to the main source, is on every path to the city
+        bool dependent = false;
+        for(uint32_t d = idom[id]; d != NO_VERTEX; d = idom[d]) {
+            Vertex *v = g.findVertex(d);
+            if(v->getType() != VertexType::PumpingStation && v->getType() != VertexType::WaterReservoir) continue;
+
+            cout << v->getCode() << " ";
+            if(outputFileIsOpen) outputFile << cityCode << "," << cityName << "," << v->getCode() << endl;
+            dependent = true;
+        }
+        if(dependent) numDependentCities++;
+        else cout << "-";
+        cout << endl;
+    }
+    cout << endl;
+
+    if(numDependentCities == 0)
+        cout << "No city depends completely on a single " << endl
+             << "pumping station or reservoir!" << endl;
+    else {
+        cout << "Note: Putting any of these service points out " << endl
+             << "of commission cuts the city off completely." << endl;
+    }
+
+    cout << endl;
+
+    if(outputFileIsOpen) {
+        outputFile.close();
+        cout << ">> Output file is at: ./output/" << networkName << "/single_points_of_failure.csv" << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the output file." << endl;
+        cout << "\033[0m";
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+}
+
 void Data::pumpingStationImpact(const string &code) {
     double maxFlow = metrics.getMaxFlow();
     double totalDemand = metrics.getTotalDemand();
 
-    Graph *newGraph = g.copyGraph();
-
-    newGraph->stationOutOfCommission(&code);
+    ScreeningStats stats;
+    FailureResult result = stationFailures({code}, stats)[0];
 
     double totalWaterSupplied = 0;
 
@@ -696,14 +1462,15 @@ void Data::pumpingStationImpact(const string &code) {
     cout << setw(10) << left << "Old Flow" << " ";
     cout << setw(10) << left << "New Flow" << endl << endl;
 
-    for(auto &pair : deliverySites) {
-        const string cityCode = pair.first;
+    size_t j = 0;
+    for(auto &pair : deliverySiteOrder) {
+        const string &cityCode = pair.first;
         DeliverySite *ds = pair.second;
 
         string cityName = ds->getCity();
         double demand = ds->getDemand();
-        double oldFlow = g.findVertex(cityCode)->getFlow();
-        double newFlow = newGraph->findVertex(cityCode)->getFlow();
+        double oldFlow = g.findVertex(ds->getVertexId())->getFlow();
+        double newFlow = result.flows[j++];
 
         totalWaterSupplied += newFlow;
 
@@ -762,24 +1529,29 @@ void Data::allPumpingStationsImpact() {
 
     if(outputFileIsOpen) outputFile << "Station Code,City Code,Demand,Old Flow,New Flow" << endl;
 
-    Graph *newGraph = g.copyGraph();
+    vector<string> codes;
+    for(auto &pair : stationOrder) codes.push_back(pair.first);
 
-    for(auto &pair : pumpingStations) {
-        string psCode = pair.first;
+    ScreeningStats stats;
+    vector<FailureResult> results = stationFailures(codes, stats);
 
-        newGraph->stationOutOfCommission(&psCode);
+    ImpactMatrix matrix = impactMatrix(codes, results);
+    vector<double> deltas = matrix.getDeltas();
+    vector<double> demands = getDeliverySiteDemands();
+    size_t n = matrix.getNumComponents();
 
-        cout << psCode << "\t >  ";
+    for(size_t k = 0; k < n; k++) {
+        const string &psCode = matrix.getComponent(k);
 
-        for(auto &dsPair : deliverySites) {
-            const string cityCode = dsPair.first;
-            DeliverySite *ds = dsPair.second;
+        cout << psCode << "\t >  ";
 
-            double demand = ds->getDemand();
-            double oldFlow = g.findVertex(cityCode)->getFlow();
-            double newFlow = newGraph->findVertex(cityCode)->getFlow();
+        for(size_t c = 0; c < matrix.getNumSites(); c++) {
+            if (deltas[c * n + k] == 0) continue;
 
-            if (oldFlow == newFlow) continue;
+            const string &cityCode = matrix.getSite(c);
+            double demand = demands[c];
+            double oldFlow = matrix.getBaseline(c);
+            double newFlow = matrix.getFlow(k, c);
 
             cout << "(" << cityCode << ", ";
             cout << fixed << setprecision(0) << demand << ", ";
@@ -792,6 +1564,9 @@ void Data::allPumpingStationsImpact() {
     }
     cout << endl;
 
+    printImpactSummary(matrix);
+    printScreeningStats(stats);
+
     if(outputFileIsOpen) {
         outputFile.close();
         cout << ">> Output file is at: ./output/" << networkName << "/stations_impact.csv" << endl;
@@ -802,6 +1577,15 @@ void Data::allPumpingStationsImpact() {
         cout << "\033[0m";
     }
 
+    if(matrix.save(dir_path / "stations_impact.bin")) {
+        cout << ">> Impact matrix is at: ./output/" << networkName << "/stations_impact.bin" << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the impact matrix file." << endl;
+        cout << "\033[0m";
+    }
+
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
     cout << "\033[0m";
@@ -811,26 +1595,26 @@ void Data::allPumpingStationsImpact() {
 
 void Data::essentialPipelines() {
     unordered_map<string, set<string>> cityToEssentialPipelines;
-    Graph *newGraph = g.copyGraph();
 
-    for(auto &pair : pipes) {
-        string pipelineCode = pair.first;
-        Pipe *pipeline = pair.second;
-
-        string servicePointA = pipeline->getServicePointA();
-        string servicePointB = pipeline->getServicePointB();
-        bool unidirectional = pipeline->getUnidirectional();
+    vector<string> codes;
+    for(uint32_t i = 0; i < pipes.size(); i++) {
+        if(pipes.isListed(i)) codes.push_back(pipes.getCode(i));
+    }
 
-        newGraph->pipelineOutOfCommission(&servicePointA, &servicePointB, unidirectional);
+    ScreeningStats stats;
+    vector<FailureResult> results = pipelineFailures(codes, stats);
 
-        for(auto &dsPair : deliverySites) {
-            const string cityCode = dsPair.first;
+    ImpactMatrix matrix = impactMatrix(codes, results);
+    vector<double> deltas = matrix.getDeltas();
+    size_t n = matrix.getNumComponents();
 
-            double oldFlow = g.findVertex(cityCode)->getFlow();
-            double newFlow = newGraph->findVertex(cityCode)->getFlow();
+    for(size_t k = 0; k < n; k++) {
+        const string &pipelineCode = matrix.getComponent(k);
 
-            if(oldFlow == newFlow) continue;
+        for(size_t c = 0; c < matrix.getNumSites(); c++) {
+            if(deltas[c * n + k] == 0) continue;
 
+            const string &cityCode = matrix.getSite(c);
             auto it = cityToEssentialPipelines.find(cityCode);
 
             if(it == cityToEssentialPipelines.end()) {
@@ -860,7 +1644,7 @@ void Data::essentialPipelines() {
     if(outputFileIsOpen) outputFile << "City Code,City Name,Pipeline Code" << endl;
 
     for(const auto &pair : cityToEssentialPipelines) {
-        string cityCode = pair.first;
+        const string &cityCode = pair.first;
         DeliverySite *ds = deliverySites.at(cityCode);
 
         string cityName = ds->getCity();
@@ -876,6 +1660,8 @@ void Data::essentialPipelines() {
     }
     cout << endl;
 
+    printScreeningStats(stats);
+
     if(outputFileIsOpen) {
         outputFile.close();
         cout << ">> Output file is at: ./output/" << networkName << "/cities_not_essential_pipelines.csv" << endl;
@@ -895,18 +1681,16 @@ void Data::pipelineImpact(const string &code) {
     double maxFlow = metrics.getMaxFlow();
     double totalDemand = metrics.getTotalDemand();
 
-    auto it = pipes.find(code);
-    if (it == pipes.end()) {
+    uint32_t pipe = pipes.find(code);
+    if (pipe == PipeTable::NO_PIPE) {
         size_t dashPos = code.find('-');
-        it = pipes.find(code.substr(dashPos + 1)+"-"+code.substr(0, dashPos));
+        pipe = pipes.find(code.substr(dashPos + 1)+"-"+code.substr(0, dashPos));
     }
 
-    string pipelineCode = (*it).first;
-    Pipe *pipeline = (*it).second;
-    string servicePointA = pipeline->getServicePointA();
-    string servicePointB = pipeline->getServicePointB();
-    bool unidirectional = pipeline->getUnidirectional();
-    double capacity = pipeline->getCapacity();
+    string pipelineCode = pipes.getCode(pipe);
+    Pipe pipeline = pipes.get(pipe);
+    bool unidirectional = pipeline.getUnidirectional();
+    double capacity = pipeline.getCapacity();
 
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
@@ -924,20 +1708,20 @@ void Data::pipelineImpact(const string &code) {
     cout << setw(10) << left << "Old Flow" << " ";
     cout << setw(10) << left << "New Flow" << endl << endl;
 
-    Graph *newGraph = g.copyGraph();
-
-    newGraph->pipelineOutOfCommission(&servicePointA, &servicePointB, unidirectional);
+    ScreeningStats stats;
+    FailureResult result = pipelineFailures({pipelineCode}, stats)[0];
 
     double totalWaterSupplied = 0;
 
-    for(auto &dsPair : deliverySites) {
-        const string cityCode = dsPair.first;
+    size_t j = 0;
+    for(auto &dsPair : deliverySiteOrder) {
+        const string &cityCode = dsPair.first;
         DeliverySite *ds = dsPair.second;
 
         string cityName = ds->getCity();
         double demand = ds->getDemand();
-        double oldFlow = g.findVertex(cityCode)->getFlow();
-        double newFlow = newGraph->findVertex(cityCode)->getFlow();
+        double oldFlow = g.findVertex(ds->getVertexId())->getFlow();
+        double newFlow = result.flows[j++];
 
         totalWaterSupplied += newFlow;
 
@@ -978,6 +1762,108 @@ void Data::pipelineImpact(const string &code) {
     cout << "\033[0m";
 }
 
+void Data::pipelineDegradation(const string &code) {
+    uint32_t pipe = pipes.find(code);
+    if (pipe == PipeTable::NO_PIPE) {
+        size_t dashPos = code.find('-');
+        pipe = pipes.find(code.substr(dashPos + 1)+"-"+code.substr(0, dashPos));
+    }
+
+    string pipelineCode = pipes.getCode(pipe);
+    Pipe pipeline = pipes.get(pipe);
+    bool unidirectional = pipeline.getUnidirectional();
+    double capacity = pipeline.getCapacity();
+
+    vector<double> levels;
+    for(int step = 0; step <= 10; step++) levels.push_back(step / 10.0);
+
+    DegradationCurve curve = g.pipelineDegradation(pipeline.getVertexA(), pipeline.getVertexB(), unidirectional,
+                                                   levels, getDeliverySiteIds());
+
+    // Only the delivery sites whose flow changes along the curve are shown
+    vector<pair<string, size_t>> affected;
+    size_t j = 0;
+    for(auto &dsPair : deliverySiteOrder) {
+        for(const vector<double> &flows : curve.flows) {
+            if(flows[j] != curve.flows.back()[j]) {
+                affected.emplace_back(dsPair.first, j);
+                break;
+            }
+        }
+        j++;
+    }
+
+    filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
+
+    if (!filesystem::exists(dir_path))
+        filesystem::create_directory(dir_path);
+
+    ofstream outputFile(dir_path / (pipelineCode + "_degradation.csv"));
+
+    bool outputFileIsOpen = outputFile.is_open();
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+    cout << ">> Pipeline Capacity Degradation: " << endl;
+    cout << "Code: " << code << endl;
+    cout << "Capacity: " << capacity << endl;
+    if(unidirectional) cout << "Unidirectional" << endl << endl;
+    else cout << "Bidirectional" << endl << endl;
+
+    if(outputFileIsOpen) {
+        outputFile << "Capacity Level,Pipe Capacity,Max Flow";
+        for(auto &dsPair : deliverySiteOrder) outputFile << "," << dsPair.first;
+        outputFile << endl;
+    }
+
+    cout << setw(10) << left << "Level" << " ";
+    cout << setw(10) << left << "Capacity" << " ";
+    cout << setw(10) << left << "Max Flow";
+    for(auto &site : affected) cout << " " << setw(10) << left << site.first;
+    cout << endl << endl;
+
+    for(size_t l = curve.levels.size(); l-- > 0;) {
+        double level = curve.levels[l];
+
+        cout << setw(10) << left << fixed << setprecision(0) << to_string((int) lround(level * 100)) + "%" << " ";
+        cout << setw(10) << left << fixed << setprecision(0) << pipeline.getDegradedCapacity(level) << " ";
+        cout << setw(10) << left << fixed << setprecision(0) << curve.maxFlows[l];
+        for(auto &site : affected) cout << " " << setw(10) << left << fixed << setprecision(0) << curve.flows[l][site.second];
+        cout << endl;
+
+        if(outputFileIsOpen) {
+            outputFile << fixed << setprecision(2) << level << "," << setprecision(0) << pipeline.getDegradedCapacity(level);
+            outputFile << "," << curve.maxFlows[l];
+            for(double flow : curve.flows[l]) outputFile << "," << flow;
+            outputFile << endl;
+        }
+    }
+
+    cout << endl;
+    cout << "Max Flow at full capacity: " << fixed << setprecision(0) << curve.fullFlow << " m3/s" << endl;
+    cout << "Max Flow without the pipeline: " << fixed << setprecision(0) << curve.failedFlow << " m3/s" << endl;
+
+    // The max flow is min(full flow, failed flow + t) for a capacity t, so it only drops below the breakpoint
+    double breakpoint = curve.fullFlow - curve.failedFlow;
+
+    if(breakpoint <= 0) {
+        cout << "> The max flow does not depend on the capacity of this pipeline!" << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "> The max flow drops once the capacity falls below " << fixed << setprecision(0) << breakpoint;
+        cout << " m3/s (" << setprecision(0) << breakpoint / capacity * 100 << "% of its capacity)!" << endl;
+        cout << "\033[0m";
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+
+    if(outputFileIsOpen) outputFile.close();
+}
+
 void Data::allPipelinesImpact() {
     filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
 
@@ -996,29 +1882,31 @@ void Data::allPipelinesImpact() {
 
     if(outputFileIsOpen) outputFile << "Pipeline Code,City Code,Demand,Old Flow,New Flow" << endl;
 
-    Graph *newGraph = g.copyGraph();
+    vector<string> codes;
+    for(uint32_t i = 0; i < pipes.size(); i++) {
+        if(pipes.isListed(i)) codes.push_back(pipes.getCode(i));
+    }
 
-    for(auto &pair : pipes) {
-        string pipelineCode = pair.first;
-        Pipe *pipeline = pair.second;
+    ScreeningStats stats;
+    vector<FailureResult> results = pipelineFailures(codes, stats);
 
-        string servicePointA = pipeline->getServicePointA();
-        string servicePointB = pipeline->getServicePointB();
-        bool unidirectional = pipeline->getUnidirectional();
+    ImpactMatrix matrix = impactMatrix(codes, results);
+    vector<double> deltas = matrix.getDeltas();
+    vector<double> demands = getDeliverySiteDemands();
+    size_t n = matrix.getNumComponents();
 
-        newGraph->pipelineOutOfCommission(&servicePointA, &servicePointB, unidirectional);
+    for(size_t k = 0; k < n; k++) {
+        const string &pipelineCode = matrix.getComponent(k);
 
         cout << "(" << pipelineCode << ")  >  ";
 
-        for(auto &dsPair : deliverySites) {
-            const string cityCode = dsPair.first;
-            DeliverySite *ds = dsPair.second;
+        for(size_t c = 0; c < matrix.getNumSites(); c++) {
+            if (deltas[c * n + k] == 0) continue;
 
-            double demand = ds->getDemand();
-            double oldFlow = g.findVertex(cityCode)->getFlow();
-            double newFlow = newGraph->findVertex(cityCode)->getFlow();
-
-            if (oldFlow == newFlow) continue;
+            const string &cityCode = matrix.getSite(c);
+            double demand = demands[c];
+            double oldFlow = matrix.getBaseline(c);
+            double newFlow = matrix.getFlow(k, c);
 
             cout << "(" << cityCode << ", "
                  << fixed << setprecision(0) << demand << ", "
@@ -1031,6 +1919,9 @@ void Data::allPipelinesImpact() {
     }
     cout << endl;
 
+    printImpactSummary(matrix);
+    printScreeningStats(stats);
+
     if(outputFileIsOpen) {
         outputFile.close();
         cout << ">> Output file is at: ./output/" << networkName << "/pipelines_impact.csv" << endl;
@@ -1041,7 +1932,200 @@ void Data::allPipelinesImpact() {
         cout << "\033[0m";
     }
 
+    if(matrix.save(dir_path / "pipelines_impact.bin")) {
+        cout << ">> Impact matrix is at: ./output/" << networkName << "/pipelines_impact.bin" << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the impact matrix file." << endl;
+        cout << "\033[0m";
+    }
+
     cout << "\033[32m";
     cout << "----------------------------------------------------" << endl;
     cout << "\033[0m";
-}
\ No newline at end of file
+}
+
+// Contingency Analysis
+
+void Data::contingencyAnalysis(unsigned int k) {
+    vector<FailureCase> components;
+    vector<string> codes;
+
+    for(auto &pair : reservoirOrder) {
+        components.push_back(FailureCase::station(pair.second->getVertexId()));
+        codes.push_back(pair.first);
+    }
+    for(auto &pair : stationOrder) {
+        components.push_back(FailureCase::station(pair.second->getVertexId()));
+        codes.push_back(pair.first);
+    }
+    for(uint32_t i = 0; i < pipes.size(); i++) {
+        if(!pipes.isListed(i)) continue;
+        Pipe pipeline = pipes.get(i);
+        components.push_back(FailureCase::pipeline(pipeline.getVertexA(), pipeline.getVertexB(), pipeline.getUnidirectional()));
+        codes.push_back(pipes.getCode(i));
+    }
+
+    ContingencyAnalyzer analyzer(&g, components, numThreads);
+    double maxFlow = analyzer.getBaselineFlow();
+
+    filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
+
+    if (!filesystem::exists(dir_path))
+        filesystem::create_directory(dir_path);
+
+    string fileName = "contingency_n" + to_string(k) + ".csv";
+    ofstream outputFile(dir_path / fileName);
+
+    bool outputFileIsOpen = outputFile.is_open();
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+    cout << ">> Contingency Analysis (N-" << k << "): " << endl << endl;
+
+    if(outputFileIsOpen) outputFile << "Failure Set,Max Flow,Lost Flow" << endl;
+
+    // Keep the combinations that lose the most flow, the first one found wins ties
+    const size_t numWorst = 10;
+    vector<pair<double, string>> worst;
+    size_t numLossy = 0;
+
+    ContingencyStats stats = analyzer.run(k, [&](const ContingencyResult &result) {
+        string failureSet;
+        for(uint32_t c : result.members) {
+            if(!failureSet.empty()) failureSet += " + ";
+            failureSet += codes[c];
+        }
+        double lostFlow = maxFlow - result.maxFlow;
+
+        if(outputFileIsOpen) outputFile << failureSet << "," << result.maxFlow << "," << lostFlow << endl;
+        numLossy++;
+
+        auto it = find_if(worst.begin(), worst.end(), [&](const pair<double, string> &w) { return w.first < lostFlow; });
+        if(it != worst.end() || worst.size() < numWorst) {
+            worst.insert(it, {lostFlow, failureSet});
+            if(worst.size() > numWorst) worst.pop_back();
+        }
+    });
+
+    cout << "Components: " << components.size() << endl;
+    cout << "Combinations evaluated: " << stats.combinations << endl;
+    cout << "Failures re-routed by the solver: " << stats.solved << endl;
+    cout << "Failures of components without flow: " << stats.skipped << endl;
+    cout << "Combinations that lower the max flow: " << numLossy << endl << endl;
+
+    if(!worst.empty()) {
+        cout << "> Combinations that lose the most flow: " << endl;
+        cout << setw(10) << left << "Lost Flow" << " " << "Failure Set" << endl << endl;
+        for(const pair<double, string> &w : worst) {
+            cout << setw(10) << left << fixed << setprecision(0) << w.first << " " << w.second << endl;
+        }
+        cout << endl;
+    }
+    cout << "Max Flow: " << fixed << setprecision(0) << maxFlow << " m3/s" << endl << endl;
+
+    if(outputFileIsOpen) {
+        outputFile.close();
+        cout << ">> Output file is at: ./output/" << networkName << "/" << fileName << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the output file." << endl;
+        cout << "\033[0m";
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+}
+
+void Data::reliabilitySimulation(uint64_t samples, double pReservoir, double pStation, double pPipeline) {
+    vector<FailureCase> components;
+    vector<double> probabilities;
+
+    for(auto &pair : reservoirOrder) {
+        components.push_back(FailureCase::station(pair.second->getVertexId()));
+        probabilities.push_back(pReservoir);
+    }
+    for(auto &pair : stationOrder) {
+        components.push_back(FailureCase::station(pair.second->getVertexId()));
+        probabilities.push_back(pStation);
+    }
+    for(uint32_t i = 0; i < pipes.size(); i++) {
+        if(!pipes.isListed(i)) continue;
+        Pipe pipeline = pipes.get(i);
+        components.push_back(FailureCase::pipeline(pipeline.getVertexA(), pipeline.getVertexB(), pipeline.getUnidirectional()));
+        probabilities.push_back(pPipeline);
+    }
+
+    vector<string> codes;
+    vector<double> demands;
+    for(auto &pair : deliverySiteOrder) {
+        codes.push_back(pair.first);
+        demands.push_back(pair.second->getDemand());
+    }
+
+    // A fixed seed gives common random numbers, so two runs only differ by their parameters
+    const uint64_t seed = 1;
+    ReliabilitySimulator simulator(&g, components, probabilities, getDeliverySiteIds(), demands, numThreads);
+    ReliabilityResult result = simulator.run(samples, seed);
+
+    filesystem::path dir_path = filesystem::path(filesystem::current_path() / ".." / "output" / networkName);
+
+    if (!filesystem::exists(dir_path))
+        filesystem::create_directory(dir_path);
+
+    string fileName = "reliability.csv";
+    ofstream outputFile(dir_path / fileName);
+
+    bool outputFileIsOpen = outputFile.is_open();
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+    cout << ">> Monte Carlo Reliability: " << endl << endl;
+
+    if(outputFileIsOpen) outputFile << "City Code,Demand,Baseline Unmet,Expected Unmet,P50,P95,P99" << endl;
+
+    cout << setw(10) << left << "City Code" << " " << setw(10) << "Demand" << " " << setw(10) << "Baseline" << " "
+         << setw(10) << "Expected" << " " << setw(10) << "P50" << " " << setw(10) << "P95" << " " << "P99" << endl << endl;
+
+    double totalExpected = 0;
+    for(size_t i = 0; i < codes.size(); i++) {
+        const SiteReliability &site = result.sites[i];
+        totalExpected += site.expectedUnmet;
+
+        cout << setw(10) << left << codes[i] << " " << fixed << setprecision(0) << setw(10) << site.demand << " "
+             << setw(10) << site.baselineUnmet << " " << setprecision(2) << setw(10) << site.expectedUnmet << " "
+             << setprecision(0) << setw(10) << site.p50Unmet << " " << setw(10) << site.p95Unmet << " "
+             << site.p99Unmet << endl;
+
+        if(outputFileIsOpen) {
+            outputFile << codes[i] << "," << site.demand << "," << site.baselineUnmet << "," << site.expectedUnmet << ","
+                       << site.p50Unmet << "," << site.p95Unmet << "," << site.p99Unmet << endl;
+        }
+    }
+    cout << endl;
+
+    cout << "Samples: " << result.samples << endl;
+    cout << "Samples without failures: " << result.noOutage << endl;
+    cout << "Samples with an already solved failure pattern: " << result.cached << endl;
+    cout << "Samples re-routed by the solver: " << result.solved << endl << endl;
+    cout << "Expected unmet demand: " << fixed << setprecision(2) << totalExpected << " m3/s" << endl << endl;
+
+    if(outputFileIsOpen) {
+        outputFile.close();
+        cout << ">> Output file is at: ./output/" << networkName << "/" << fileName << endl;
+    }
+    else {
+        cout << "\033[31m";
+        cout << "There was an error creating/writing the output file." << endl;
+        cout << "\033[0m";
+    }
+
+    cout << "\033[32m";
+    cout << "----------------------------------------------------" << endl;
+    cout << "\033[0m";
+}
@@ -16,6 +16,52 @@ using namespace std;
 #include "PumpingStation.h"
 #include "DeliverySite.h"
 #include "Pipe.h"
+#include "PipeTable.h"
+#include "FailureSweep.h"
+#include "FailureAnalyzer.h"
+#include "ImpactCache.h"
+#include "ImpactMatrix.h"
+#include "MinCutTable.h"
+#include "CsvReader.h"
+#include "NetworkSnapshot.h"
+
+/**
+* @brief Row of a water reservoirs file. The strings are views into the mapped file.
+*/
+struct ReservoirRow {
+    string_view name;
+    string_view municipality;
+    string_view code;
+    double id;
+    double maxDelivery;
+};
+
+/**
+* @brief Row of a pumping stations file. The code is a view into the mapped file.
+*/
+struct StationRow {
+    string_view code;
+    double id;
+};
+
+/**
+* @brief Row of a cities file. The strings are views into the mapped file.
+*/
+struct CityRow {
+    string_view name;
+    string_view code;
+    double id;
+    double demand;
+    double population;
+};
+
+/**
+* @brief Pipes parsed from a byte range of a pipes file, with their service points already resolved to vertex ids.
+*/
+struct PipeChunk {
+    vector<EdgeSpec> pipes;                     // one record per row, in file order
+    vector<pair<string, string>> unknownCodes;  // codes of the rows with a missing service point, in file order
+};
 
 /**
  * @brief Class that saves all the program data.
@@ -26,10 +72,143 @@ private:
     unordered_map<string, WaterReservoir *> waterReservoirs;
     unordered_map<string, PumpingStation *> pumpingStations;
     unordered_map<string, DeliverySite *> deliverySites;
-    unordered_map<string, Pipe *> pipes;
+    // The entities in the order every report visits them, which is saved in the network snapshots
+    vector<pair<string, WaterReservoir *>> reservoirOrder;
+    vector<pair<string, PumpingStation *>> stationOrder;
+    vector<pair<string, DeliverySite *>> deliverySiteOrder;
     string networkName;
     Graph g;
+    PipeTable pipes{&g};
     GraphMetrics metrics;
+    unsigned int numThreads = 0;
+    uint64_t inputsFingerprint = 0;
+    ImpactCache impactCache;
+    MinCutTable minCutTable;
+
+    /**
+     * @brief Opens the impact cache of the loaded network and max-flow solver.
+     *
+     * @details The fingerprint of the cache combines the hash of the input files with the name of the max-flow solver,
+     * since the solver decides how the flow is split among the delivery sites. The cache file is kept with the output
+     * files of the network.
+     *
+     * @complexity O(n * s), where n is the number of cached failure sets and s is the number of delivery sites.
+     */
+    void openImpactCache();
+
+    /**
+     * @brief Retrieves the vertex ids of the delivery sites.
+     *
+     * @return The vertex ids of the delivery sites, in the order of 'deliverySiteOrder'.
+     *
+     * @complexity O(n), where n is the number of delivery sites.
+     */
+    vector<uint32_t> getDeliverySiteIds() const;
+
+    /**
+     * @brief Retrieves the demand of the delivery sites.
+     *
+     * @return The demand of the delivery sites, in the order of 'deliverySiteOrder'.
+     *
+     * @complexity O(n), where n is the number of delivery sites.
+     */
+    vector<double> getDeliverySiteDemands() const;
+
+    /**
+     * @brief Retrieves the current flow of the delivery sites.
+     *
+     * @return The flow of the delivery sites, in the order of 'deliverySiteOrder'.
+     *
+     * @complexity O(n), where n is the number of delivery sites.
+     */
+    vector<double> getDeliverySiteFlows() const;
+
+    /**
+     * @brief Builds the impact matrix of the results of a failure sweep.
+     *
+     * @param codes The codes of the failed components, in the order of the results.
+     * @param results The results, with the flow of every delivery site in the order of 'deliverySiteOrder'.
+     *
+     * @return The matrix, with the current flow of every delivery site as its baseline.
+     *
+     * @complexity O(n * s), where n is the number of components and s is the number of delivery sites.
+     */
+    ImpactMatrix impactMatrix(const vector<string> &codes, const vector<FailureResult> &results) const;
+
+    /**
+     * @brief Prints the worst failure of every city and the failures that lose the most water.
+     *
+     * @param matrix The impact matrix of a failure sweep.
+     *
+     * @complexity O(n * s + n * log(n)), where n is the number of components and s is the number of delivery sites.
+     */
+    void printImpactSummary(const ImpactMatrix &matrix) const;
+
+    /**
+     * @brief Evaluates the given pipelines out of commission.
+     *
+     * @details Pipelines whose result is in the impact cache are not evaluated again. The remaining failures are first
+     * screened with FailureAnalyzer::classifyPipeline(), from the baseline max flow and a minimum cut found in its
+     * residual graph. A pipeline without flow, or whose flow fits in a residual path around it, keeps the baseline flow
+     * and is not evaluated at all. A pipeline whose flow crosses the minimum cut only has its flow cancelled, since
+     * nothing can be re-routed. Only the remaining pipelines are evaluated with the max-flow solver. The failures are
+     * evaluated by a FailureSweep, and their results are added to the impact cache.
+     *
+     * @param codes The codes of the pipelines, as given by PipeTable::getCode().
+     * @param stats The counters where the outcome of the screening is added.
+     *
+     * @return The result of every pipeline failure, in the order of 'codes', with the flow of every delivery site in
+     * the order of 'deliverySiteOrder'.
+     *
+     * @complexity O(n * s) when every pipeline is cached, where n is the number of pipelines and s is the number of
+     * delivery sites. Otherwise, O(V + E) to screen each pipeline with flow, plus O(k * (V + E)) to cancel the flow of
+     * each of the P pipelines that were not bypassed, plus the complexity of the max-flow solver for each of the
+     * pipelines that were not classified.
+     */
+    vector<FailureResult> pipelineFailures(const vector<string> &codes, ScreeningStats &stats);
+
+    /**
+     * @brief Evaluates the given pumping stations or reservoirs out of commission.
+     *
+     * @details Stations whose result is in the impact cache are not evaluated again. Among the remaining ones, a station
+     * without incoming flow keeps the baseline flow and is not evaluated at all. The others are evaluated by a
+     * FailureSweep, and their results are added to the impact cache.
+     *
+     * @param codes The codes of the pumping stations or reservoirs.
+     * @param stats The counters where the outcome of the screening is added.
+     *
+     * @return The result of every station failure, in the order of 'codes', with the flow of every delivery site in the
+     * order of 'deliverySiteOrder'.
+     *
+     * @complexity O(n * s) when every station is cached, where n is the number of stations and s is the number of
+     * delivery sites. Otherwise, O(V + E) to build the sweep, plus the cost of a FailureSweep over the stations with flow.
+     */
+    vector<FailureResult> stationFailures(const vector<string> &codes, ScreeningStats &stats);
+
+    /**
+     * @brief Decides which of the given pumping stations or reservoirs are essential to maintain the max flow.
+     *
+     * @details A station whose edges cross the minimum cut of the baseline is essential without any solve, since the
+     * max flow drops by at least their capacity, see FailureAnalyzer::stationLossBound(). The other stations are
+     * evaluated by stationFailures().
+     *
+     * @param codes The codes of the pumping stations or reservoirs.
+     * @param stats The counters where the outcome of the screening is added.
+     *
+     * @return Whether each station is essential, in the order of 'codes'.
+     *
+     * @complexity O(V + E) to screen the stations, plus the cost of stationFailures() over the undecided ones.
+     */
+    vector<bool> essentialStations(const vector<string> &codes, ScreeningStats &stats);
+
+    /**
+     * @brief Prints how many failures of a report were answered without the max-flow solver, and how.
+     *
+     * @param stats The counters of the screening.
+     *
+     * @complexity O(1).
+     */
+    void printScreeningStats(const ScreeningStats &stats) const;
 public:
     /**
     * @brief Default constructor for the Data class.
@@ -39,6 +218,14 @@ public:
     */
     Data();
 
+    /**
+    * @brief Destructor for the Data class.
+    *
+    * @details Deallocates the reservoirs, pumping stations, delivery sites and pipes of the network. The vertices and
+    * edges are released by the graph.
+    */
+    ~Data();
+
     /**
      * @brief Retrieves the name of the network.
      *
@@ -46,101 +233,230 @@ public:
      */
     string getNetworkName() const;
 
+    /**
+     * @brief Retrieves the solver used to compute the maximum flow of the network.
+     *
+     * @return The max-flow solver used by the network graph.
+     */
+    const MaxFlowSolver *getMaxFlowSolver() const;
+
+    /**
+     * @brief Sets the solver used to compute the maximum flow of the network.
+     *
+     * @details If a network is already loaded, its maximum flow and metrics are recomputed from scratch with the
+     * new solver, so every report is consistent with the selected solver. The impact cache of the new solver is opened.
+     *
+     * @param solver The max-flow solver to be used, or nullptr to use the default solver.
+     *
+     * @complexity O(1) if no network is loaded, otherwise the complexity of the solver.
+     */
+    void setMaxFlowSolver(const MaxFlowSolver *solver);
+
+    /**
+     * @brief Retrieves the number of threads used by the failure sweeps.
+     *
+     * @return The number of threads, or 0 if one thread per hardware thread is used.
+     */
+    unsigned int getNumThreads() const;
+
+    /**
+     * @brief Sets the number of threads used by the failure sweeps.
+     *
+     * @details The failure sweeps evaluate every reservoir, pumping station or pipeline out of commission in
+     * parallel. Their reports do not depend on the number of threads.
+     *
+     * @param threads The number of threads, or 0 to use one thread per hardware thread.
+     */
+    void setNumThreads(unsigned int threads);
+
     /**
      * @brief Reads data files containing information about reservoirs, stations, cities, and pipes.
      *
      * @details This function reads data files from the specified directory path and populates the network with the
      * information contained in these files. It identifies the appropriate files based on their names containing specific
-     * substrings ('Reservoir', 'Stations', 'Cities', 'Pipes'). It then opens each file, reads its contents, and calls
-     * respective functions to parse and process the data. After reading all necessary files, it calculates the maximum
-     * flow in the network and metrics based on the provided data.
+     * substrings ('Reservoir', 'Stations', 'Cities', 'Pipes'). The pipes may be sharded into several 'Pipes_part<k>'
+     * files, which are read in the order of k as if they were one file.
+     *
+     * The files are parsed in two phases. First every file is parsed at the same time, and large pipes files are split
+     * into byte ranges of whole rows that are parsed in parallel too, using the number of threads set with
+     * setNumThreads(). Then the entities are added in file order and the graph is built in one bulk step, so the
+     * vertex ids, the edges and the order of every map are the same as when the files were read one after another.
+     *
+     * After reading all necessary files, it calculates the maximum flow in the network and metrics based on the
+     * provided data. Finally, it hashes the contents of the files and opens the impact cache of that fingerprint, so
+     * results cached for other contents are never served.
      *
      * @param dir_path The directory path containing the data files.
      *
      * @throw runtime_error if there are errors in opening or reading the files, or if multiple files of the same type
      * are found, or if any required file is missing.
      *
-     * @complexity The time complexity of this function depends on the number of files in the directory and the complexity
-     * of processing each file. Let n be the number of files in the directory:
-     * - Iterating over the files and identifying the appropriate files each take O(n) time.
-     * - Opening each file and reading its contents take O(1) time.
-     * - Calling readFileReservoir, readFileStations, readFileCities, and readFilePipes each takes O(n) time in total,
-     *   assuming the number of lines in each file is proportional to n.
-     * - Calculating the maximum flow and metrics using Graph methods each takes O(V + E^2) time in the worst case.
-     * Therefore, the overall time complexity is O(V + E^2).
+     * @complexity O(n / T + V + E * d + F), where n is the size of the files, T is the number of threads, V is the
+     * number of vertices, E is the number of edges, d is the largest number of edges leaving a vertex and F is the
+     * complexity of the max-flow solver.
      */
     void readFiles(const filesystem::path &dir_path);
 
     /**
-     * @brief Reads water reservoir data from a file and populates the network.
+     * @brief Saves the loaded network as a binary snapshot.
+     *
+     * @details The snapshot holds everything readFiles() builds: the entities, the graph, its baseline max flow, the
+     * metrics and the fingerprint of the input files. It also holds the whole reservoir to city min-cut table, so the
+     * pairs not queried yet are solved first.
+     *
+     * @param path The path of the snapshot file.
+     *
+     * @return True if the snapshot was written.
+     *
+     * @complexity O(V + E + R * C + P * F / T), where V is the number of vertices, E is the number of edges, R is the
+     * number of reservoirs, C is the number of cities, P is the number of pairs not queried yet, F is the complexity of
+     * the max-flow solver and T is the number of threads.
+     */
+    bool saveSnapshot(const filesystem::path &path);
+
+    /**
+     * @brief Saves the loaded network as a snapshot in its output folder, as '<network>.wsnet'.
+     *
+     * @details Prints the path of the snapshot, or an error if it could not be written. The snapshot is loaded again
+     * by giving its path instead of a directory when loading a network.
+     *
+     * @complexity The one of saveSnapshot().
+     */
+    void saveNetworkSnapshot();
+
+    /**
+     * @brief Loads a network from a binary snapshot written by saveSnapshot().
+     *
+     * @details The snapshot is mapped into memory and its records are read in place, so nothing is parsed and the max
+     * flow is not solved again. The entities are added in the order of their records, which is the order the reports
+     * visited them when the snapshot was written, and the edges are added in creation order, so every report and
+     * failure analysis gives the same results as the network loaded from its files. If the selected max-flow solver is
+     * not the one of the snapshot, the baseline max flow is solved again with it.
+     *
+     * @param path The path of the snapshot file.
+     *
+     * @throw runtime_error if the file cannot be read or is not a valid snapshot.
+     *
+     * @complexity O(V + E + R * C), where V is the number of vertices, E is the number of edges, R is the number of
+     * reservoirs and C is the number of cities.
+     */
+    void readSnapshot(const filesystem::path &path);
+
+    /**
+     * @brief Parses the rows of a water reservoirs file.
+     *
+     * @details Each row is expected to contain the name, municipality, id, code and maximum delivery of a water
+     * reservoir. The header row is skipped, and so are rows without a name, municipality or code. Nothing is added to
+     * the network, so several files can be parsed at the same time.
+     *
+     * @param file The CSV reader of the file containing water reservoir data.
+     * @param rows The vector where the parsed rows are appended.
+     *
+     * @complexity O(n), where n is the size of the file.
+     */
+    static void parseReservoirs(CsvReader &file, vector<ReservoirRow> &rows);
+
+    /**
+     * @brief Parses the rows of a pumping stations file.
+     *
+     * @details Each row is expected to contain the id and code of a pumping station. The header row is skipped, and so
+     * are rows without a code.
+     *
+     * @param file The CSV reader of the file containing pumping station data.
+     * @param rows The vector where the parsed rows are appended.
+     *
+     * @complexity O(n), where n is the size of the file.
+     */
+    static void parseStations(CsvReader &file, vector<StationRow> &rows);
+
+    /**
+     * @brief Parses the rows of a cities file.
+     *
+     * @details Each row is expected to contain the name, id, code, demand and population of a city. The header row is
+     * skipped, and so are rows without a name or code.
+     *
+     * @param file The CSV reader of the file containing city data.
+     * @param rows The vector where the parsed rows are appended.
+     *
+     * @complexity O(n), where n is the size of the file.
+     */
+    static void parseCities(CsvReader &file, vector<CityRow> &rows);
+
+    /**
+     * @brief Parses the rows of a byte range of a pipes file into packed pipe records.
+     *
+     * @details Each row is expected to contain the two service points, capacity and direction of a pipe. Rows without
+     * both service points are skipped. The service points are resolved to their vertex ids right away, so only the
+     * records are kept, not the rows. Disjoint ranges of the same file can be parsed at the same time, once every
+     * vertex has been added.
+     *
+     * @param file The CSV reader of the file containing pipe data, past its header row.
+     * @param range The [begin, end) byte offsets of the rows, given by CsvReader::splitRows().
+     * @param chunk The chunk where the parsed pipes are appended.
+     *
+     * @complexity O(n), where n is the size of the range.
+     */
+    void parsePipes(CsvReader &file, pair<size_t, size_t> range, PipeChunk &chunk) const;
+
+    /**
+     * @brief Adds the parsed water reservoirs to the network.
      *
-     * @details This function reads water reservoir data from the given file stream. Each line in the file is expected
-     * to contain information about a water reservoir, including ID, name, municipality, code, and maximum delivery.
-     * The function parses each line, creates WaterReservoir objects, and adds them to the network as vertices. It also
-     * adds the water reservoirs to the waterReservoirs map.
+     * @details Creates a WaterReservoir and a vertex for each row, in order, and adds them to the waterReservoirs map.
+     * When a code is repeated, the first water reservoir is kept.
      *
-     * @param file The input file stream containing water reservoir data.
+     * @param rows The parsed rows of the water reservoirs file.
      *
-     * @complexity The time complexity of this function depends on the number of lines in the file and the complexity
-     * of parsing each line. Let n be the number of lines in the file:
-     * - Parsing each line involves O(1) operations.
-     * - Inserting a vertex into the graph and adding a water reservoir to the map each take O(1) time.
-     * Therefore, the overall time complexity is O(n).
+     * @complexity O(n), where n is the number of rows.
      */
-    void readFileReservoir(ifstream &file);
+    void addReservoirs(const vector<ReservoirRow> &rows);
 
     /**
-     * @brief Reads pumping station data from a file and populates the network.
+     * @brief Adds the parsed pumping stations to the network.
      *
-     * @details This function reads pumping station data from the given file stream. Each line in the file is expected
-     * to contain information about a pumping station, including ID and code. The function parses each line, creates
-     * PumpingStation objects, and adds them to the network as vertices. It also adds the pumping stations to the
-     * pumpingStations map.
+     * @details Creates a PumpingStation and a vertex for each row, in order, and adds them to the pumpingStations map.
+     * When a code is repeated, the first pumping station is kept.
      *
-     * @param file The input file stream containing pumping station data.
+     * @param rows The parsed rows of the pumping stations file.
      *
-     * @complexity The time complexity of this function depends on the number of lines in the file and the complexity
-     * of parsing each line. Let n be the number of lines in the file:
-     * - Parsing each line involves O(1) operations.
-     * - Inserting a vertex into the graph and adding a pumping station to the map each take O(1) time.
-     * Therefore, the overall time complexity is O(n).
+     * @complexity O(n), where n is the number of rows.
      */
-    void readFileStations(ifstream &file);
+    void addStations(const vector<StationRow> &rows);
 
     /**
-     * @brief Reads city data from a file and populates the network.
+     * @brief Adds the parsed cities to the network.
      *
-     * @details This function reads city data from the given file stream. Each line in the file is expected to contain
-     * information about a city, including city name, code, ID, demand, and population. The function parses each line,
-     * creates DeliverySite objects, and adds them to the network as vertices. It also adds the delivery sites to the
-     * deliverySites map.
+     * @details Creates a DeliverySite and a vertex for each row, in order, and adds them to the deliverySites map.
+     * When a code is repeated, the first delivery site is kept.
      *
-     * @param file The input file stream containing city data.
+     * @param rows The parsed rows of the cities file.
      *
-     * @complexity The time complexity of this function depends on the number of lines in the file and the complexity
-     * of parsing each line. Let n be the number of lines in the file:
-     * - Parsing each line involves O(1) operations.
-     * - Inserting a vertex into the graph and adding a delivery site to the map each take O(1) time.
-     * Therefore, the overall time complexity is O(n).
+     * @complexity O(n), where n is the number of rows.
      */
-    void readFileCities(ifstream &file);
+    void addCities(const vector<CityRow> &rows);
 
     /**
-     * @brief Reads pipe data from a file and populates the network.
+     * @brief Fixes the order in which the reports visit the entities, once every entity of the network was added.
      *
-     * @details This function reads pipe data from the given file stream. Each line in the file is expected to contain
-     * information about a pipe, including service points, capacity, and direction. The function parses each line,
-     * creates Pipe objects, and adds them to the network. It also adds edges to the graph representing the pipes.
+     * @details The order is the iteration order of the maps at that point. It is kept apart from the maps, so it is
+     * saved in the network snapshots as it is and a network loaded from a snapshot gives the same reports, whatever the
+     * standard library does with the maps.
      *
-     * @param file The input file stream containing pipe data.
+     * @complexity O(n), where n is the number of entities.
+     */
+    void recordEntityOrder();
+
+    /**
+     * @brief Adds the parsed pipes to the network.
+     *
+     * @details The pipe table grows once, then the records of every chunk are appended to it in order, and each chunk
+     * is released as soon as it has been copied. The graph is then built from the table in a single Graph::addEdges()
+     * call, after every chunk is gone.
+     *
+     * @param chunks The parsed pipes of the pipes files, in file order. They are emptied.
      *
-     * @complexity The time complexity of this function depends on the number of lines in the file and the complexity
-     * of parsing each line. Let n be the number of lines in the file:
-     * - Parsing each line involves O(1) operations.
-     * - Inserting a pipe into the map and adding edges to the graph each take O(1) time.
-     * Therefore, the overall time complexity is O(n).
+     * @complexity O(n + V + E * d), where n is the number of rows and V, E and d are as in Graph::addEdges().
      */
-    void readFilePipes(ifstream &file);
+    void addPipes(vector<PipeChunk> &chunks);
 
     /**
      * @brief Checks if a delivery site exists in the network.
@@ -218,6 +534,35 @@ public:
      */
     void cityMaxFlow(const string &code);
 
+    /**
+     * @brief Displays the maximum flow from a specific reservoir to a specific city, and its minimum cut.
+     *
+     * @details The value and the cut are looked up in the minimum cut table, which holds the max flow of every
+     * reservoir and city pair with every other reservoir and city disconnected. A pair is solved on its first query and
+     * kept, and a network loaded from a snapshot has every pair solved already. The cut edges are printed as their
+     * service points, with the supply of the reservoir and the demand of the city shown as edges of their own when they
+     * limit the flow.
+     *
+     * @param reservoirCode The code of the reservoir.
+     * @param cityCode The code of the city.
+     *
+     * @complexity O(k) once the pair was solved, where k is the number of edges of the minimum cut, and
+     * O(V + E + C + F) on its first query, where V is the number of vertices, E is the number of edges, C is the number
+     * of cities and F is the complexity of the max-flow solver.
+     */
+    void reservoirCityMaxFlow(const string &reservoirCode, const string &cityCode);
+
+    /**
+     * @brief Displays the largest factor by which the demand of every city can grow while the network still meets it.
+     *
+     * @details The factor is found by a warm-started bisection over the demands held by the edges into the main target,
+     * to a relative precision of 1e-6. This function prints the factor, the total demand it allows, the pipelines and
+     * reservoirs of the cut that limits the growth, and the cities behind that cut.
+     *
+     * @complexity About 20 to 40 runs of the max-flow solver, each only augmenting the flow added by the growth.
+     */
+    void maxDemandGrowth();
+
     /**
      * @brief Calculates and displays the maximum flow for each city in the network.
      *
@@ -286,6 +631,7 @@ public:
      * distribution system, helping in assessing the resilience of the network and planning for contingencies.
      *
      * @param code The code of the reservoir to be deactivated.
+     * The result is served from the impact cache when this reservoir was already evaluated for the same input files.
      *
      * @complexity The time complexity of this function depends on the size of the network and the number of delivery sites.
      * The biggest contributor to the overall time complexity is the execution of the Edmonds-Karp algorithm, which has a
@@ -301,6 +647,9 @@ public:
      * flow. It computes the change in flow for each city served by the reservoirs and outputs the results to both the
      * console and a CSV file. The function provides insights into how the deactivation of reservoirs affects the water
      * distribution system, helping in assessing the resilience of the network and planning for contingencies.
+     * Reservoirs already in the impact cache are not evaluated again.
+     * The results go through an ImpactMatrix, which also gives the worst reservoir of each city, the reservoirs that lose
+     * the most water, and the binary file reservoirs_impact.bin.
      *
      * @complexity The time complexity of this function depends on the size of the network and the number of delivery sites and reservoirs.
      * The biggest contributor to the overall time complexity is the execution of the Edmonds-Karp algorithm, which has a
@@ -340,6 +689,7 @@ public:
      * of each pumping station in maintaining the network's functionality.
      *
      * @param code The code of the pumping station to be analyzed for its impact on the network.
+     * A pumping station already evaluated for the same input files is answered from the impact cache.
      *
      * @complexity The time complexity of this function depends on the size of the network and the number of delivery sites.
      * The biggest contributor to the overall time complexity is the execution of the Edmonds-Karp algorithm, which has a
@@ -358,6 +708,9 @@ public:
      * including the pumping station code, city code, demand, old flow, and new flow to the console and optionally to a CSV file.
      * Additionally, it creates an output directory if it doesn't exist and saves the results in a CSV file. The function provides
      * insights into the impact of each pumping station on the water flow to each city in the network.
+     * Pumping stations already in the impact cache are not evaluated again.
+     * The report is generated from an ImpactMatrix, which is also written to stations_impact.bin and summarized by the
+     * worst pumping station of each city and the ones that lose the most water.
      *
      * @complexity The time complexity of this function depends on the size of the network and the number of delivery sites and pumping stations.
      * The biggest contributor to the overall time complexity is the execution of the Edmonds-Karp algorithm, which has a
@@ -366,6 +719,21 @@ public:
      */
     void allPumpingStationsImpact();
 
+    /**
+     * @brief Identifies the pumping stations and reservoirs that each city depends on completely.
+     *
+     * @details This function computes the dominator tree of the network, rooted at the main source, with the
+     * Lengauer-Tarjan algorithm. A service point dominates a city when every pipeline path from the main source to the
+     * city goes through it, so putting it out of commission cuts the city off completely, whatever the max flow does.
+     * For each city, the pumping stations and reservoirs on its path up the dominator tree are output to the console
+     * and to a CSV file. Cities that cannot be reached from any reservoir are reported as not supplied. No max flow is
+     * computed, so this is an instant first pass of the pumping station and reservoir impact reports.
+     *
+     * @complexity O(E * log(V) + n * V), where V is the number of vertices, E is the number of edges and n is the
+     * number of delivery sites.
+     */
+    void singlePointsOfFailure();
+
     /**
      * @brief Identifies essential pipelines for each city in the network.
      *
@@ -396,6 +764,7 @@ public:
      * its water needs without the pipeline and whether the pipeline is essential to maintain the current max flow.
      *
      * @param code The code of the pipeline for which the impact is to be calculated.
+     * A pipeline already evaluated for the same input files is answered from the impact cache.
      *
      * @complexity The time complexity of this function depends on the size of the network and the number of delivery sites.
      * The biggest contributor to the overall time complexity is the execution of the Edmonds-Karp algorithm, which has a
@@ -404,6 +773,21 @@ public:
      */
     void pipelineImpact(const string &code);
 
+    /**
+     * @brief Calculates the max flow of the network while the capacity of a specific pipeline degrades down to zero.
+     *
+     * @details This function scales the capacity of the pipeline from 100% down to 0% in steps of 10%, and prints the
+     * max flow and the flow of the affected delivery sites at each step. The curve comes from one parametric solve
+     * that starts from the pipeline out of commission and raises its capacity step by step, and the capacity below
+     * which the max flow starts to drop is given exactly. The curve is also written to a CSV file.
+     *
+     * @param code The code of the pipeline to be degraded.
+     *
+     * @complexity The complexity of one pipeline failure, plus one solve per step that only augments the flow added by
+     * the capacity of that step.
+     */
+    void pipelineDegradation(const string &code);
+
     /**
      * @brief Calculates the impact of each pipeline on the flow of delivery sites and saves the results to a CSV file.
      *
@@ -412,6 +796,9 @@ public:
      * each pipeline in the network, temporarily taking each pipeline out of commission and recalculating the flow of delivery
      * sites. It prints the impact of each pipeline on the flow of each delivery site to the console and writes the results to
      * the CSV file. Finally, it closes the output file and displays the path to the file if it was successfully created.
+     * Pipelines already in the impact cache are not evaluated again, so repeating the sweep costs no solve.
+     * The report is generated from an ImpactMatrix, which is also written to pipelines_impact.bin and summarized by the
+     * worst pipeline of each city and the ones that lose the most water.
      *
      * @complexity The time complexity of this function depends on the size of the network and the number of delivery sites and pumping stations.
      * The biggest contributor to the overall time complexity is the execution of the Edmonds-Karp algorithm, which has a
@@ -419,6 +806,43 @@ public:
      * However, in practice, it performs efficiently, because it never executes the Edmonds-Karp from the beginning.
      */
     void allPipelinesImpact();
+
+    // Contingency Analysis
+
+    /**
+     * @brief Analyzes every combination of k simultaneous failures of reservoirs, pumping stations and pipelines.
+     *
+     * @details This function evaluates every N-k contingency of the network with a ContingencyAnalyzer, which warm starts
+     * every combination from the flow of its (k-1)-subset and skips the solve for components that carry no flow. The
+     * combinations that lower the max flow are written to a CSV file, with the water they supply and the flow they lose.
+     * The console shows how many combinations were evaluated, how many failures needed the max-flow solver, and the
+     * combinations that lose the most flow.
+     *
+     * @param k The number of simultaneous failures.
+     *
+     * @complexity O(C(n, k) * F / T) in the worst case, where n is the number of reservoirs, pumping stations and
+     * pipelines, F is the complexity of repairing the flow of one failure and T is the number of threads.
+     */
+    void contingencyAnalysis(unsigned int k);
+
+    /**
+     * @brief Simulates the unmet demand of every city under random failures of reservoirs, pumping stations and pipelines.
+     *
+     * @details This function draws the given number of samples with a ReliabilitySimulator, where every reservoir, pumping
+     * station and pipeline is out of commission independently with the failure probability of its type. The simulation
+     * always uses the same seed, so runs with different probabilities or solvers see the same random numbers and can be
+     * compared directly. The expected unmet demand and its 50th, 95th and 99th percentiles for every city are written to a
+     * CSV file and shown in the console, with how many samples needed the max-flow solver.
+     *
+     * @param samples The number of samples.
+     * @param pReservoir The failure probability of every reservoir.
+     * @param pStation The failure probability of every pumping station.
+     * @param pPipeline The failure probability of every pipeline.
+     *
+     * @complexity O(S * (n + F) / T), where S is the number of samples, n is the number of reservoirs, pumping stations
+     * and pipelines, F is the complexity of repairing the flow of the failures of one sample and T is the number of threads.
+     */
+    void reliabilitySimulation(uint64_t samples, double pReservoir, double pStation, double pPipeline);
 };
 
 
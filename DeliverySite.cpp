@@ -1,7 +1,7 @@
 #include "DeliverySite.h"
 
-DeliverySite::DeliverySite(string city, double id, string code, double demand, double population)
-    : city(std::move(city)), id(id), code(std::move(code)), demand(demand), population(population) {}
+DeliverySite::DeliverySite(string city, double id, string code, uint32_t vertexId, double demand, double population)
+    : city(std::move(city)), id(id), code(std::move(code)), vertexId(vertexId), demand(demand), population(population) {}
 
 string DeliverySite::getCity() {
     return city;
@@ -9,4 +9,16 @@ string DeliverySite::getCity() {
 
 double DeliverySite::getDemand() const {
     return demand;
-}
\ No newline at end of file
+}
+
+double DeliverySite::getId() const {
+    return id;
+}
+
+double DeliverySite::getPopulation() const {
+    return population;
+}
+
+uint32_t DeliverySite::getVertexId() const {
+    return vertexId;
+}
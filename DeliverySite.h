@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <cstdint>
 #include <utility>
 using namespace std;
 
@@ -15,6 +16,7 @@ private :
     string city;
     double id;
     string code;
+    uint32_t vertexId;
     double demand;
     double population;
 
@@ -26,10 +28,11 @@ public:
      * @param city The city associated with the delivery site.
      * @param id The ID of the delivery site.
      * @param code The code associated with the delivery site.
+     * @param vertexId The id of the vertex representing the delivery site in the network graph.
      * @param demand The demand of the delivery site.
      * @param population The population associated with the delivery site.
      */
-    DeliverySite(string city, double id, string code, double demand, double population);
+    DeliverySite(string city, double id, string code, uint32_t vertexId, double demand, double population);
 
     /**
      * @brief Get the city associated with the delivery site.
@@ -44,6 +47,27 @@ public:
      * @return The demand of the delivery site.
      */
     [[nodiscard]] double getDemand() const;
+
+    /**
+     * @brief Get the ID of the delivery site.
+     *
+     * @return The ID of the delivery site.
+     */
+    [[nodiscard]] double getId() const;
+
+    /**
+     * @brief Get the population associated with the delivery site.
+     *
+     * @return The population of the delivery site.
+     */
+    [[nodiscard]] double getPopulation() const;
+
+    /**
+     * @brief Get the id of the vertex representing the delivery site in the network graph.
+     *
+     * @return The vertex id of the delivery site.
+     */
+    [[nodiscard]] uint32_t getVertexId() const;
 };
 
 
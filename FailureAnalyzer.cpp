@@ -0,0 +1,74 @@
+#include "FailureAnalyzer.h"
+
+FailureAnalyzer::FailureAnalyzer(Graph *g) : rg(g), solver(g->getMaxFlowSolver()) {
+    rg.saveFlows(baselineFlows);
+    rg.findSourceSide(sourceSide);
+
+    siteVertex.assign(rg.getNumVertices(), 0);
+    Vertex *target = g->findVertex(g->getMainTargetId());
+    if(target == nullptr) return;
+
+    for(Edge *e : target->getIncoming()) {
+        Vertex *site = e->getOrig();
+        siteVertex[site->getId()] = 1;
+        for(Edge *out : site->getAdj()) {
+            if(out->getDest() != target) transitSites = true;
+        }
+    }
+}
+
+void FailureAnalyzer::restoreBaseline() {
+    rg.restoreFlows(baselineFlows);
+
+    if(failedVertex != NO_VERTEX) rg.activateVertex(failedVertex);
+    if(failedOrig != NO_VERTEX) rg.activateEdge(failedOrig, failedDest, failedUnidirectional);
+
+    failedVertex = NO_VERTEX;
+    failedOrig = NO_VERTEX;
+    failedDest = NO_VERTEX;
+}
+
+void FailureAnalyzer::stationOutOfCommission(uint32_t id) {
+    restoreBaseline();
+
+    // Remove only the flow routed through the station and re-route it around the station
+    rg.cancelFlowThroughVertex(id);
+    rg.deactivateVertex(id);
+    failedVertex = id;
+
+    solver->solve(rg);
+}
+
+void FailureAnalyzer::pipelineOutOfCommission(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional, bool reroute) {
+    restoreBaseline();
+
+    // Remove only the flow routed through the pipeline and re-route it around the pipeline
+    rg.cancelFlowThroughEdge(servicePointA, servicePointB, unidirectional);
+    rg.deactivateEdge(servicePointA, servicePointB, unidirectional);
+    failedOrig = servicePointA;
+    failedDest = servicePointB;
+    failedUnidirectional = unidirectional;
+
+    if(reroute) solver->solve(rg);
+}
+
+PipelineFailure FailureAnalyzer::classifyPipeline(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional) const {
+    if(!rg.hasFlowThroughEdge(servicePointA, servicePointB, unidirectional)) return PipelineFailure::NoFlow;
+    if(rg.isCutEdge(servicePointA, servicePointB, unidirectional, sourceSide)) return PipelineFailure::CutEdge;
+    if(rg.findBypass(servicePointA, servicePointB, unidirectional, siteVertex)) return PipelineFailure::Bypass;
+    return PipelineFailure::Reroute;
+}
+
+double FailureAnalyzer::stationLossBound(uint32_t id) const {
+    // The water that goes through a delivery site on to other vertices is counted as supplied but does not cross the cut
+    if(transitSites) return 0;
+    return rg.getCutCapacity(id, sourceSide);
+}
+
+double FailureAnalyzer::getVertexFlow(uint32_t id) const {
+    return rg.getIncomingFlow(id);
+}
+
+double FailureAnalyzer::getMaxFlow() const {
+    return rg.getSuppliedFlow();
+}
@@ -0,0 +1,167 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_FAILURE_ANALYZER_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_FAILURE_ANALYZER_H
+
+
+#include <vector>
+#include "Graph.h"
+#include "ResidualGraph.h"
+#include "MaxFlowSolver.h"
+
+using namespace std;
+
+/**
+* @brief How much work a pipeline failure needs, as classified by FailureAnalyzer::classifyPipeline().
+*/
+enum class PipelineFailure {
+    NoFlow,         // the pipeline carries no flow, so the baseline flow is kept as it is
+    CutEdge,        // the flow of the pipeline crosses a minimum cut, so it is lost and nothing can be re-routed
+    Bypass,         // the flow of the pipeline fits in a residual path around it, so every delivery site keeps its flow
+    Reroute         // the flow of the pipeline may be re-routed, so the max-flow solver has to run
+};
+
+/**
+* @brief Counters of how the failures of a sweep were answered.
+*/
+struct ScreeningStats {
+    size_t components = 0;      // failures asked for
+    size_t cached = 0;          // answered by the impact cache
+    size_t noFlow = 0;          // components without flow, which keep the baseline flow
+    size_t bypassed = 0;        // pipelines whose flow is moved to a residual path around them
+    size_t bounded = 0;         // answered by the minimum cut: pipelines that cross it, stations proven essential by it
+    size_t solved = 0;          // sent to the max-flow solver
+};
+
+/**
+* @brief Evaluates the failure of single components of a network by repairing its baseline max flow.
+*
+* @details The analyzer keeps the residual graph of the network together with the baseline max flow. When a component
+* fails, only the flow routed through it is cancelled and the max-flow solver re-routes the lost flow around it,
+* instead of solving the whole network again. Before every failure the baseline flow is restored, so failures can be
+* evaluated one after the other on the same analyzer.
+*/
+class FailureAnalyzer {
+private:
+    ResidualGraph rg;
+    vector<double> baselineFlows;
+    const MaxFlowSolver *solver;
+    vector<char> sourceSide;            // source side of a minimum cut of the baseline flow
+    vector<char> siteVertex;            // vertices with an edge to the target, whose incoming flow is reported
+    bool transitSites = false;          // whether a delivery site forwards water to other vertices
+
+
+    uint32_t failedVertex = NO_VERTEX;  // vertex deactivated by the last failure
+    uint32_t failedOrig = NO_VERTEX;    // pipeline deactivated by the last failure
+    uint32_t failedDest = NO_VERTEX;
+    bool failedUnidirectional = true;
+
+public:
+
+    /**
+     * @brief Builds an analyzer for the given graph.
+     *
+     * @details The current flow of the graph is taken as the baseline, so the graph must hold its max flow.
+     * Failures are repaired with the max-flow solver of the graph. The source side of a minimum cut of the baseline
+     * is also found, to classify pipeline failures.
+     *
+     * @param g Pointer to the graph to be analyzed.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    explicit FailureAnalyzer(Graph *g);
+
+    /**
+     * @brief Restores the baseline flow and reactivates the component of the last failure.
+     *
+     * @complexity O(E), where E is the number of edges in the graph.
+     */
+    void restoreBaseline();
+
+    /**
+     * @brief Puts a pumping station or reservoir out of commission, starting from the baseline flow.
+     *
+     * @details The flow going through the vertex is cancelled, the vertex is deactivated and the max-flow solver
+     * re-augments only the flow that was lost.
+     *
+     * @param id The id of the pumping station or reservoir.
+     *
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the vertex, plus the complexity of the solver
+     * to re-route the lost flow.
+     */
+    void stationOutOfCommission(uint32_t id);
+
+    /**
+     * @brief Puts a pipeline out of commission, starting from the baseline flow.
+     *
+     * @details The flow going through the edges of the pipeline is cancelled, the edges are deactivated and the
+     * max-flow solver re-augments only the flow that was lost. If the pipeline was classified as PipelineFailure::NoFlow
+     * or PipelineFailure::CutEdge, 'reroute' can be false to skip the solver, since it would not change the flow.
+     *
+     * @param servicePointA The id of the first service point.
+     * @param servicePointB The id of the second service point.
+     * @param unidirectional Indicates whether the pipeline is unidirectional (true) or bidirectional (false).
+     * @param reroute Indicates whether the lost flow is re-routed by the max-flow solver.
+     *
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the pipeline, plus the complexity of the solver
+     * to re-route the lost flow if 'reroute' is true.
+     */
+    void pipelineOutOfCommission(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional, bool reroute = true);
+
+    /**
+     * @brief Classifies the failure of a pipeline from the baseline flow alone.
+     *
+     * @details A pipeline without flow cannot change the baseline flow when it fails. A pipeline whose flow crosses
+     * a minimum cut of the baseline loses all of its flow when it fails, and the remaining flow is already a max flow.
+     * A pipeline whose flow fits in a residual path around it that avoids the delivery sites, see
+     * ResidualGraph::findBypass(), keeps the max flow and the flow of every delivery site. Only the other pipelines
+     * need the max-flow solver to find their outcome.
+     *
+     * @param servicePointA The id of the first service point.
+     * @param servicePointB The id of the second service point.
+     * @param unidirectional Indicates whether the pipeline is unidirectional (true) or bidirectional (false).
+     *
+     * @return The classification of the pipeline failure.
+     *
+     * @complexity O(d), where d is the number of edges of both service points, unless the pipeline is checked for a
+     * bypass, which is O(V + E).
+     */
+    [[nodiscard]] PipelineFailure classifyPipeline(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional) const;
+
+    /**
+     * @brief Bounds the flow lost when a pumping station or reservoir goes out of commission.
+     *
+     * @details The edges of the station that cross the minimum cut of the baseline leave the network with it, so the
+     * capacity of that cut, and therefore the max flow, drops by at least their capacity. If a delivery site forwards
+     * water to other vertices, its incoming flow is not bounded by the cut and the bound is always 0.
+     *
+     * @param id The id of the pumping station or reservoir.
+     *
+     * @return A lower bound of the flow supplied to the delivery sites that is lost by the failure.
+     *
+     * @complexity O(d), where d is the number of edges of the station.
+     */
+    [[nodiscard]] double stationLossBound(uint32_t id) const;
+
+    /**
+     * @brief Get the flow entering a vertex in the current state.
+     *
+     * @param id The id of the vertex.
+     *
+     * @return The incoming flow of the vertex, as Vertex::getFlow() would return after the same failure.
+     *
+     * @complexity O(d), where d is the number of edges of the vertex.
+     */
+    [[nodiscard]] double getVertexFlow(uint32_t id) const;
+
+    /**
+     * @brief Get the water supplied to the delivery sites in the current state.
+     *
+     * @return The sum of the incoming flow of every delivery site, as Graph::getTotalDemandAndMaxFlow() would
+     * return after the same failure.
+     *
+     * @complexity O(E), where E is the number of edges in the graph.
+     */
+    [[nodiscard]] double getMaxFlow() const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_FAILURE_ANALYZER_H
@@ -0,0 +1,82 @@
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "FailureSweep.h"
+
+FailureCase FailureCase::station(uint32_t id) {
+    FailureCase c;
+    c.vertex = id;
+    return c;
+}
+
+FailureCase FailureCase::pipeline(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional, bool reroute) {
+    FailureCase c;
+    c.servicePointA = servicePointA;
+    c.servicePointB = servicePointB;
+    c.unidirectional = unidirectional;
+    c.reroute = reroute;
+    return c;
+}
+
+FailureSweep::FailureSweep(Graph *g, vector<uint32_t> observed, unsigned int numThreads)
+        : prototype(g), observed(std::move(observed)), numThreads(numThreads) {
+    if(this->numThreads == 0) this->numThreads = max(1u, thread::hardware_concurrency());
+}
+
+const FailureAnalyzer &FailureSweep::getAnalyzer() const {
+    return prototype;
+}
+
+FailureResult FailureSweep::getBaseline() const {
+    FailureResult result;
+    result.maxFlow = prototype.getMaxFlow();
+    result.flows.reserve(observed.size());
+    for(uint32_t id : observed) result.flows.push_back(prototype.getVertexFlow(id));
+    return result;
+}
+
+vector<FailureResult> FailureSweep::run(const vector<FailureCase> &cases) const {
+    vector<FailureResult> results(cases.size());
+    atomic<size_t> next(0);
+    exception_ptr error = nullptr;
+    mutex errorMutex;
+
+    // Every worker repairs the flow on its own analyzer, and writes only the results of the cases it picked up
+    auto worker = [&](FailureAnalyzer analyzer) {
+        try {
+            for(size_t i = next++; i < cases.size(); i = next++) {
+                const FailureCase &c = cases[i];
+
+                if(c.vertex != NO_VERTEX) analyzer.stationOutOfCommission(c.vertex);
+                else analyzer.pipelineOutOfCommission(c.servicePointA, c.servicePointB, c.unidirectional, c.reroute);
+
+                FailureResult &result = results[i];
+                result.maxFlow = analyzer.getMaxFlow();
+                result.flows.reserve(observed.size());
+                for(uint32_t id : observed) result.flows.push_back(analyzer.getVertexFlow(id));
+            }
+        }
+        catch(...) {
+            lock_guard<mutex> lock(errorMutex);
+            if(error == nullptr) error = current_exception();
+            next = cases.size();
+        }
+    };
+
+    size_t workers = min<size_t>(numThreads, cases.size());
+
+    if(workers <= 1) {
+        worker(prototype);
+    }
+    else {
+        vector<thread> threads;
+        threads.reserve(workers);
+        for(size_t i = 0; i < workers; i++) threads.emplace_back(worker, prototype);
+        for(thread &t : threads) t.join();
+    }
+
+    if(error != nullptr) rethrow_exception(error);
+
+    return results;
+}
@@ -0,0 +1,120 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_FAILURE_SWEEP_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_FAILURE_SWEEP_H
+
+
+#include <vector>
+#include "Graph.h"
+#include "FailureAnalyzer.h"
+
+using namespace std;
+
+/**
+* @brief Component put out of commission in one case of a failure sweep.
+*
+* @details A case is either a pumping station or reservoir ('vertex' is set) or a pipeline ('vertex' is NO_VERTEX and
+* the service points of the pipeline are set).
+*/
+struct FailureCase {
+    uint32_t vertex = NO_VERTEX;
+    uint32_t servicePointA = NO_VERTEX;
+    uint32_t servicePointB = NO_VERTEX;
+    bool unidirectional = true;
+    bool reroute = true;            // whether the lost flow of a pipeline is re-routed by the max-flow solver
+
+    /**
+     * @brief Builds the case of a pumping station or reservoir out of commission.
+     *
+     * @param id The id of the pumping station or reservoir.
+     *
+     * @return The failure case.
+     */
+    static FailureCase station(uint32_t id);
+
+    /**
+     * @brief Builds the case of a pipeline out of commission.
+     *
+     * @param servicePointA The id of the first service point.
+     * @param servicePointB The id of the second service point.
+     * @param unidirectional Indicates whether the pipeline is unidirectional (true) or bidirectional (false).
+     * @param reroute Indicates whether the lost flow is re-routed, see FailureAnalyzer::pipelineOutOfCommission().
+     *
+     * @return The failure case.
+     */
+    static FailureCase pipeline(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional, bool reroute = true);
+};
+
+/**
+* @brief Result of one case of a failure sweep.
+*/
+struct FailureResult {
+    double maxFlow = 0;         // water supplied to the delivery sites
+    vector<double> flows;       // incoming flow of every observed vertex, in the order they were given
+};
+
+/**
+* @brief Evaluates many failure cases of a network in parallel.
+*
+* @details Every worker thread owns a copy of a FailureAnalyzer, so it has its own residual graph and flow state, and
+* picks up the next case that was not evaluated yet. Since every case starts from the baseline flow, its result does
+* not depend on the worker that evaluated it, and the results are returned in the order of the cases, so the reports
+* written from them are the same for any number of threads.
+*/
+class FailureSweep {
+private:
+    FailureAnalyzer prototype;
+    vector<uint32_t> observed;
+    unsigned int numThreads;
+
+public:
+
+    /**
+     * @brief Builds a sweep for the given graph.
+     *
+     * @details The current flow of the graph is taken as the baseline, so the graph must hold its max flow.
+     *
+     * @param g Pointer to the graph to be analyzed.
+     * @param observed The ids of the vertices whose incoming flow is recorded for every case.
+     * @param numThreads The number of worker threads, or 0 to use one per hardware thread.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    FailureSweep(Graph *g, vector<uint32_t> observed, unsigned int numThreads);
+
+    /**
+     * @brief Get the analyzer copied by every worker, holding the baseline flow.
+     *
+     * @return Read-only reference to the analyzer.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] const FailureAnalyzer &getAnalyzer() const;
+
+    /**
+     * @brief Get the incoming flow of every observed vertex in the baseline flow.
+     *
+     * @return The baseline result, which is also the result of any failure that does not change the flow.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    [[nodiscard]] FailureResult getBaseline() const;
+
+    /**
+     * @brief Evaluates every failure case.
+     *
+     * @details The cases are split among the worker threads. If a worker fails, the first error is rethrown once all
+     * workers have finished.
+     *
+     * @param cases The failure cases to be evaluated.
+     *
+     * @return The result of every case, in the same order as 'cases'.
+     *
+     * @throws std::logic_error if the max-flow solver fails.
+     *
+     * @complexity O(C * (V + E + F) / T), where C is the number of cases, F is the complexity of repairing the flow
+     * of one case and T is the number of threads.
+     */
+    vector<FailureResult> run(const vector<FailureCase> &cases) const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_FAILURE_SWEEP_H
@@ -1,17 +1,21 @@
 #include <utility>
 #include <valarray>
 #include "Graph.h"
-#include "Algorithms.h"
+#include "MaxFlowSolver.h"
 
 /************************* Vertex  **************************/
 
-Vertex::Vertex(string code, VertexType type) : code(std::move(code)), type(type) {}
+Vertex::Vertex(uint32_t id, string code, VertexType type) : id(id), code(std::move(code)), type(type) {}
 
 bool Vertex::operator<(Vertex & vertex) const {
     return this->dist < vertex.dist;
 }
 
-string Vertex::getCode() const {
+uint32_t Vertex::getId() const {
+    return this->id;
+}
+
+const string &Vertex::getCode() const {
     return this->code;
 }
 
@@ -19,7 +23,7 @@ VertexType Vertex::getType() const {
     return this->type;
 }
 
-vector<Edge *> Vertex::getAdj() const {
+const vector<Edge *> &Vertex::getAdj() const {
     return this->adj;
 }
 
@@ -31,7 +35,7 @@ Edge *Vertex::getPath() const {
     return this->path;
 }
 
-vector<Edge *> Vertex::getIncoming() const {
+const vector<Edge *> &Vertex::getIncoming() const {
     return this->incoming;
 }
 
@@ -77,8 +81,8 @@ void Vertex::setPath(Edge *newPath) {
     this->path = newPath;
 }
 
-Edge * Vertex::addEdge(Vertex *dest, double c, double f) {
-    auto newEdge = new Edge(this, dest, c);
+Edge * Vertex::addEdge(Arena<Edge> &edges, Vertex *dest, double c, double f) {
+    Edge *newEdge = edges.create(this, dest, c);
     newEdge->setFlow(f);
     adj.push_back(newEdge);
     dest->incoming.push_back(newEdge);
@@ -87,14 +91,18 @@ Edge * Vertex::addEdge(Vertex *dest, double c, double f) {
 
 Edge * Vertex::findEdge(Vertex *destVertex) {
     for(auto e : adj) {
-        Vertex *dest = e->getDest();
-        if(dest->getCode() == destVertex->getCode()) {
+        if(e->getDest() == destVertex) {
             return e;
         }
     }
     return nullptr;
 }
 
+void Vertex::reserveEdges(size_t numOutgoing, size_t numIncoming) {
+    adj.reserve(adj.size() + numOutgoing);
+    incoming.reserve(incoming.size() + numIncoming);
+}
+
 /********************** Edge  ****************************/
 
 Edge::Edge(Vertex *orig, Vertex *dest, double capacity) : orig(orig), dest(dest), capacity(capacity) {}
@@ -130,40 +138,34 @@ void Edge::setFlow(double newFlow) {
 
 /********************** Graph  ****************************/
 
-// Copy Graph
-
-Graph *Graph::copyGraph() {
-    auto *newGraph = new Graph();
+// Flow Checkpoints
 
-    // Copy vertices
-    for(auto &pair : vertices) {
-        string code = pair.first;
-        Vertex *v = pair.second;
+void Graph::saveFlows(FlowSnapshot &snapshot) const {
+    snapshot.edgeFlows.clear();
+    snapshot.vertexFlows.resize(vertices.size());
 
-        newGraph->addVertex(code, v->getType());
+    for(Vertex *v : vertices) {
+        for(Edge *e : v->getAdj()) {
+            snapshot.edgeFlows.push_back(e->getFlow());
+        }
+        snapshot.vertexFlows[v->getId()] = v->getFlow();
     }
+}
 
-    // Copy edges
-    for(auto &pair : vertices) {
-        string code = pair.first;
-        Vertex *v = pair.second;
-
-        for(auto e : v->getAdj()) {
-            string origin = e->getOrig()->getCode();
-            string dest = e->getDest()->getCode();
-            double capacity = e->getCapacity();
-            double flow = e->getFlow();
+void Graph::restoreFlows(const FlowSnapshot &snapshot) {
+    size_t i = 0;
 
-            newGraph->addEdge(origin, dest, capacity, flow);
+    for(Vertex *v : vertices) {
+        for(Edge *e : v->getAdj()) {
+            e->setFlow(snapshot.edgeFlows[i++]);
         }
+        v->setFlow(snapshot.vertexFlows[v->getId()]);
     }
-    newGraph->updateAllVerticesFlow();
-    return newGraph;
 }
 
 // Metrics
 
-GraphMetrics Graph::calculateMetrics(const unordered_map<string, DeliverySite *> *deliverySites) {
+GraphMetrics Graph::calculateMetrics() {
     // Absolute metrics
     double absoluteAverage;
     double absoluteVariance;
@@ -182,17 +184,15 @@ GraphMetrics Graph::calculateMetrics(const unordered_map<string, DeliverySite *>
     double relativeSum = 0;
 
     // Determine total demand and the max flow
-    auto totalDemandAndMaxFlow = getTotalDemandAndMaxFlow(deliverySites);
+    auto totalDemandAndMaxFlow = getTotalDemandAndMaxFlow();
     double totalDemand = totalDemandAndMaxFlow.first;
     double maxFlow = totalDemandAndMaxFlow.second;
 
     // Determine average
-    for(auto &pair : vertices) {
-        const Vertex *v = pair.second;
-
+    for(const Vertex *v : vertices) {
         for(auto e : v->getAdj()) {
             // Ignore auxiliary edges
-            if(e->getOrig()->getCode() == mainSourceCode || e->getDest()->getCode() == mainTargetCode) continue;
+            if(e->getOrig()->getId() == mainSourceId || e->getDest()->getId() == mainTargetId) continue;
 
             double absoluteDifference = e->getCapacity() - e->getFlow();
             double relativeDifference = ( e->getCapacity() - e->getFlow() ) / e->getCapacity();
@@ -216,9 +216,7 @@ GraphMetrics Graph::calculateMetrics(const unordered_map<string, DeliverySite *>
     relativeSum = 0;
 
     // Determine variance
-    for(auto &pair : vertices) {
-        const Vertex *v = pair.second;
-
+    for(const Vertex *v : vertices) {
         for(auto e : v->getAdj()) {
             double absoluteDifference = e->getCapacity() - e->getFlow();
             double relativeDifference = ( e->getCapacity() - e->getFlow() ) / e->getCapacity();
@@ -253,51 +251,72 @@ GraphMetrics Graph::calculateMetrics(const unordered_map<string, DeliverySite *>
 }
 
 // Determine total demand and the max flow
-pair<double, double> Graph::getTotalDemandAndMaxFlow(const unordered_map<string, DeliverySite *> *deliverySites) const {
+pair<double, double> Graph::getTotalDemandAndMaxFlow() const {
     double maxFlow = 0;
     double totalDemand = 0;
 
-    for(auto &pair : *deliverySites) {
-        const string code = pair.first;
-        double flow = this->findVertex(code)->getFlow();
+    Vertex *mainTarget = findVertex(mainTargetId);
+    if(mainTarget == nullptr) return {totalDemand, maxFlow};
+
+    // Every delivery site is connected to the main target by an edge with its demand as capacity
+    for(auto e : mainTarget->getIncoming()) {
+        double flow = e->getOrig()->getFlow();
         maxFlow += flow;
-        totalDemand += pair.second->getDemand();
+        totalDemand += e->getCapacity();
     }
 
     return {totalDemand, maxFlow};
 }
 
-string Graph::getMainSourceCode() {
-    return mainSourceCode;
+uint32_t Graph::getMainSourceId() const {
+    return mainSourceId;
 }
 
-string Graph::getMainTargetCode() {
-    return mainTargetCode;
+uint32_t Graph::getMainTargetId() const {
+    return mainTargetId;
 }
 
-Vertex *Graph::findVertex(const string &code) const {
-    auto it = this->vertices.find(code);
-    if (it != this->vertices.end()) {
-        return it->second;
+const MaxFlowSolver *Graph::getMaxFlowSolver() const {
+    if(solver == nullptr) return MaxFlowSolverRegistry::getInstance()->getDefaultSolver();
+    return solver;
+}
+
+void Graph::setMaxFlowSolver(const MaxFlowSolver *maxFlowSolver) {
+    this->solver = maxFlowSolver;
+}
+
+Vertex *Graph::findVertex(uint32_t id) const {
+    if (id < this->vertices.size()) {
+        return this->vertices[id];
     }
     return nullptr;
 }
 
-bool Graph::addVertex(const string &code, const VertexType &type) {
-    if(findVertex(code) == nullptr) {
-        auto *newVertex = new Vertex(code, type);
-        this->vertices.insert({code, newVertex});
-        return true;
+uint32_t Graph::findVertexId(const string &code) const {
+    auto it = this->vertexIds.find(code);
+    if (it != this->vertexIds.end()) {
+        return it->second;
     }
-    return false;
+    return NO_VERTEX;
+}
+
+uint32_t Graph::addVertex(const string &code, const VertexType &type) {
+    uint32_t id = findVertexId(code);
+    if(id == NO_VERTEX) {
+        id = (uint32_t) this->vertices.size();
+        Vertex *newVertex = vertexArena.create(id, code, type);
+        this->vertices.push_back(newVertex);
+        this->vertexIds.insert({code, id});
+    }
+    return id;
 }
 
-bool Graph::addEdge(const string &source, const string &dest, double c, double f) const {
+bool Graph::addEdge(uint32_t source, uint32_t dest, double c, double f) {
     Vertex *originVertex = findVertex(source);
     Vertex *destVertex = findVertex(dest);
 
     if (originVertex && destVertex) {
-        auto e1 = originVertex->addEdge(destVertex, c, f);
+        auto e1 = originVertex->addEdge(edgeArena, destVertex, c, f);
         auto e2 = destVertex->findEdge(originVertex);
 
         if(e2 != nullptr) {
@@ -312,27 +331,64 @@ bool Graph::addEdge(const string &source, const string &dest, double c, double f
     return false;
 }
 
-bool Graph::addBidirectionalEdge(const string &source, const string &dest, double c, double flow, double reverseFlow) const {
+bool Graph::addBidirectionalEdge(uint32_t source, uint32_t dest, double c, double flow, double reverseFlow) {
     auto v1 = findVertex(source);
     auto v2 = findVertex(dest);
     if (v1 == nullptr || v2 == nullptr)
         return false;
-    auto e1 = v1->addEdge(v2, c, flow);
-    auto e2 = v2->addEdge(v1, c, reverseFlow);
+    auto e1 = v1->addEdge(edgeArena, v2, c, flow);
+    auto e2 = v2->addEdge(edgeArena, v1, c, reverseFlow);
     e1->setReverse(e2);
     e2->setReverse(e1);
     return true;
 }
 
-unordered_map<string, Vertex *> Graph::getVertexSet() const {
+void Graph::addEdges(const vector<EdgeSpec> &edges) {
+    size_t n = vertices.size();
+    vector<size_t> numOutgoing(n, 0), numIncoming(n, 0);
+
+    for(const EdgeSpec &e : edges) {
+        if(e.source >= n || e.dest >= n) continue;
+        numOutgoing[e.source]++;
+        numIncoming[e.dest]++;
+        if(e.bidirectional) {
+            numOutgoing[e.dest]++;
+            numIncoming[e.source]++;
+        }
+    }
+    for(size_t v = 0; v < n; v++) vertices[v]->reserveEdges(numOutgoing[v], numIncoming[v]);
+
+    for(const EdgeSpec &e : edges) {
+        if(e.bidirectional) addBidirectionalEdge(e.source, e.dest, e.capacity);
+        else addEdge(e.source, e.dest, e.capacity);
+    }
+}
+
+const vector<Vertex *> &Graph::getVertexSet() const {
     return this->vertices;
 }
 
+size_t Graph::getNumEdges() const {
+    return edgeArena.size();
+}
+
+Edge *Graph::getEdge(size_t i) const {
+    return edgeArena.get(i);
+}
+
+Edge *Graph::addUnpairedEdge(uint32_t source, uint32_t dest, double c, double f) {
+    return vertices[source]->addEdge(edgeArena, vertices[dest], c, f);
+}
+
+void Graph::setMainVertices(uint32_t source, uint32_t target) {
+    mainSourceId = source;
+    mainTargetId = target;
+}
+
 // All Vertices/Edges Flow
 
 void Graph::setAllEdgesFlow(double f) {
-    for(auto &pair : vertices) {
-        Vertex *v = pair.second;
+    for(Vertex *v : vertices) {
         for(auto e : v->getAdj()) {
             e->setFlow(f);
         }
@@ -340,15 +396,13 @@ void Graph::setAllEdgesFlow(double f) {
 }
 
 void Graph::setAllVerticesFlow(double f) {
-    for(auto &pair : vertices) {
-        Vertex *v = pair.second;
+    for(Vertex *v : vertices) {
         v->setFlow(f);
     }
 }
 
 void Graph::updateAllVerticesFlow() {
-    for (auto &pair : vertices) {
-        Vertex *v = pair.second;
+    for (Vertex *v : vertices) {
         v->updateFlow();
     }
 }
@@ -356,33 +410,33 @@ void Graph::updateAllVerticesFlow() {
 // Main Source & Main Target
 
 void Graph::createMainSource(const unordered_map<string, WaterReservoir *> *waterReservoirs) {
-    this->addVertex(mainSourceCode, VertexType::MainSource);
+    mainSourceId = this->addVertex(mainSourceCode, VertexType::MainSource);
 
     for (auto& pair : *waterReservoirs) {
-        string wrCode = pair.first;
         WaterReservoir* wr = pair.second;
+        uint32_t wrId = wr->getVertexId();
         double maxDelivery = wr->getMaxDelivery();
 
-        auto it = this->findVertex(wrCode);
+        auto it = this->findVertex(wrId);
         double f = (*it).getFlow();
 
-        this->addEdge(mainSourceCode, wrCode, maxDelivery, f);
+        this->addEdge(mainSourceId, wrId, maxDelivery, f);
 
     }
 }
 
 void Graph::createMainTarget(const unordered_map<string, DeliverySite *> *deliverySites) {
-    this->addVertex(mainTargetCode, VertexType::MainTarget);
+    mainTargetId = this->addVertex(mainTargetCode, VertexType::MainTarget);
 
     for (auto& pair : *deliverySites) {
-        string dsCode = pair.first;
         DeliverySite* ds = pair.second;
+        uint32_t dsId = ds->getVertexId();
         double demand = ds->getDemand();
 
-        auto it = this->findVertex(dsCode);
+        auto it = this->findVertex(dsId);
         double f = (*it).getFlow();
 
-        this->addEdge(dsCode, mainTargetCode, demand, f);
+        this->addEdge(dsId, mainTargetId, demand, f);
     }
 }
 
@@ -395,19 +449,22 @@ void Graph::maxFlow(const unordered_map<string, WaterReservoir *> *waterReservoi
     this->setAllEdgesFlow(0);
     this->setAllVerticesFlow(0);
 
-    edmondsKarp(this);
+    this->runMaxFlow();
+}
+
+void Graph::runMaxFlow() {
+    getMaxFlowSolver()->maxFlow(this);
 }
 
 // Load Optimization & Auxiliary Functions
 
-void Graph::optimizeLoad(const unordered_map<string, DeliverySite *> *deliverySites) {
-    GraphMetrics initialMetrics = this->calculateMetrics(deliverySites);
+void Graph::optimizeLoad() {
+    GraphMetrics initialMetrics = this->calculateMetrics();
     GraphMetrics finalMetrics = initialMetrics;
 
     vector<Edge *> edges;
 
-    for (auto &pair : vertices) {
-        Vertex *v = pair.second;
+    for (Vertex *v : vertices) {
         for (Edge *e : v->getAdj()) {
             edges.push_back(e);
         }
@@ -430,7 +487,7 @@ void Graph::optimizeLoad(const unordered_map<string, DeliverySite *> *deliverySi
 
             if(edge->getFlow() == 0) break;
 
-            paths = this->getPaths(edge->getOrig()->getCode(), edge->getDest()->getCode());
+            paths = this->getPaths(edge->getOrig()->getId(), edge->getDest()->getId());
 
             if(paths.empty()) continue;
 
@@ -453,7 +510,7 @@ void Graph::optimizeLoad(const unordered_map<string, DeliverySite *> *deliverySi
         }
 
         initialMetrics = finalMetrics;
-        finalMetrics = this->calculateMetrics(deliverySites);
+        finalMetrics = this->calculateMetrics();
         iterations++;
     } while((finalMetrics.getAbsoluteVariance() < initialMetrics.getAbsoluteVariance()
             || finalMetrics.getRelativeVariance() < initialMetrics.getRelativeVariance()
@@ -465,12 +522,11 @@ void Graph::optimizeLoad(const unordered_map<string, DeliverySite *> *deliverySi
 
 // Load Optimization Auxiliary Functions
 
-vector<vector<Edge *>> Graph::getPaths(const string& source, const string &dest) {
+vector<vector<Edge *>> Graph::getPaths(uint32_t source, uint32_t dest) {
     vector<vector<Edge *>> paths;
     vector<Edge *> path;
 
-    for(auto &pair : vertices) {
-        Vertex *v = pair.second;
+    for(Vertex *v : vertices) {
         v->setVisited(false);
     }
 
@@ -479,7 +535,7 @@ vector<vector<Edge *>> Graph::getPaths(const string& source, const string &dest)
     return paths;
 }
 
-void Graph::dfs(const string &current, const string &dest, vector<Edge *> &path, vector<vector<Edge *>> &paths) {
+void Graph::dfs(uint32_t current, uint32_t dest, vector<Edge *> &path, vector<vector<Edge *>> &paths) {
     Vertex *source = findVertex(current);
     source->setVisited(true);
 
@@ -491,7 +547,7 @@ void Graph::dfs(const string &current, const string &dest, vector<Edge *> &path,
             Vertex *u = e->getDest();
             if(!u->isVisited() && e->getCapacity() - e->getFlow() > 0) {
                 path.push_back(e);
-                dfs(u->getCode(), dest, path, paths);
+                dfs(u->getId(), dest, path, paths);
                 path.pop_back();
             }
         }
@@ -500,173 +556,20 @@ void Graph::dfs(const string &current, const string &dest, vector<Edge *> &path,
 
 // Out of Commission Functions
 
-void Graph::stationOutOfCommission(string const *code) {
-    edmondsKarp(this);
-
-    Vertex *ps = findVertex(*code);
-
-    this->deactivateVertex(ps);
-
-    edmondsKarpWithDeactivatedVertex(this, *code);
-
-    this->updateAllVerticesFlow();
+void Graph::stationOutOfCommission(uint32_t id) {
+    getMaxFlowSolver()->maxFlowWithDeactivatedVertex(this, id);
 }
 
-void Graph::pipelineOutOfCommission(string const *servicePointA, string const *servicePointB, bool unidirectional) {
-    edmondsKarp(this);
-
-    Vertex *origin = findVertex(*servicePointA);
-    Vertex *dest = findVertex(*servicePointB);
-
-    this->deactivateVertex(origin);
-
-    if(!unidirectional)
-        this->deactivateVertex(dest);
-
-    edmondsKarpWithDeactivatedEdge(this, *servicePointA, *servicePointB, unidirectional);
-
-    this->updateAllVerticesFlow();
+void Graph::pipelineOutOfCommission(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional) {
+    getMaxFlowSolver()->maxFlowWithDeactivatedEdge(this, servicePointA, servicePointB, unidirectional);
 }
 
-// Deactivate Vertex & Auxiliary Functions
-
-void Graph::deactivateVertex(Vertex *deactivatedVertex) {
-    while(deactivatedVertex->hasFlow()) {
-        // Check for flow cycles
-        if(detectAndDeactivateFlowCycles(deactivatedVertex)) continue;
-        // Find a path between the Master Source and the Master Target that passes through the Deactivated Vertex
-        findAndDeactivateFlowPath(deactivatedVertex);
-    }
-}
-
-bool Graph::detectAndDeactivateFlowCycles(Vertex *deactivatedVertex) {
-    // Initialize the vertices
-    for(auto const &pair : vertices) {
-        Vertex *v = pair.second;
-        v->setVisited(false);
-        v->setPath(nullptr);
-    }
-
-    queue<Vertex *> q;
-    q.push(deactivatedVertex);
-    deactivatedVertex->setVisited(true);
-    bool cycleFound = false;
-
-    while (!q.empty()) {
-
-        if(cycleFound) break;
-
-        Vertex *u = q.front();
-        q.pop();
-
-        for (Edge *e: u->getAdj()) {
-            Vertex *w = e->getDest();
-            if (w->getCode() == deactivatedVertex->getCode() && e->getFlow() > 0) {
-                w->setPath(e);
-                cycleFound = true;
-                break;
-            }
-            if (!w->isVisited() && e->getFlow() > 0) {
-                q.push(w);
-                w->setVisited(true);
-                w->setPath(e);
-            }
-        }
-    }
-
-    // No cycles found
-    if(!cycleFound) return false;
-
-    double f = INF;
-
-    // Traverse the path to find the minimum residual capacity
-    Vertex *v = deactivatedVertex;
-    while (true) {
-        auto e = v->getPath();
-        f = std::min(f, e->getFlow());
-        v = e->getOrig();
-        if(v->getCode() == deactivatedVertex->getCode())
-            break;
-    }
-
-    // Traverse the path and update the flow values accordingly
-    v = deactivatedVertex;
-    while (true) {
-        auto e = v->getPath();
-        double flow = e->getFlow();
-        e->setFlow(flow - f);
-        v = e->getOrig();
-        if(v->getCode() == deactivatedVertex->getCode())
-            break;
-    }
-
-    // Found a cycle
-    return true;
+DemandGrowth Graph::maxDemandGrowth(double tolerance) {
+    return getMaxFlowSolver()->maxDemandGrowth(this, tolerance);
 }
 
-void Graph::findAndDeactivateFlowPath(Vertex *deactivatedVertex) {
-    Vertex *mainSource = findVertex(mainSourceCode);
-    Vertex *mainTarget = findVertex(mainTargetCode);
-
-    // Initialize the vertices
-    for(auto const &pair : vertices) {
-        Vertex *v = pair.second;
-        v->setVisited(false);
-        v->setPath(nullptr);
-    }
-
-    queue<Vertex *> q;
-
-    // Find a path from the deactivated vertex to the target
-    q.push(deactivatedVertex);
-    deactivatedVertex->setVisited(true);
-    while (!q.empty()) {
-        Vertex *u = q.front();
-        q.pop();
-        for (Edge *e: u->getAdj()) {
-            Vertex *w = e->getDest();
-            if (!w->isVisited() && e->getFlow() > 0) {
-                q.push(w);
-                w->setVisited(true);
-                w->setPath(e);
-            }
-        }
-    }
-
-    // Find a path from the source to the deactivated vertex
-    q.push(mainSource);
-    deactivatedVertex->setVisited(false);
-    mainSource->setVisited(true);
-    while (!q.empty()) {
-        Vertex *u = q.front();
-        q.pop();
-        for (Edge *e: u->getAdj()) {
-            Vertex *w = e->getDest();
-            if (!w->isVisited() && e->getFlow() > 0) {
-                q.push(w);
-                w->setVisited(true);
-                w->setPath(e);
-            }
-        }
-    }
-
-    double f = INF;
-    // Traverse the path to find the minimum residual capacity
-    for (Vertex *v = mainTarget; v->getCode() != mainSourceCode; ) {
-        auto e = v->getPath();
-        if(v->getCode() != mainSourceCode && e == nullptr)
-            break;
-        f = std::min(f, e->getFlow());
-        v = e->getOrig();
-    }
-
-    // Traverse the path and update the flow values accordingly
-    for (Vertex *v = mainTarget; v->getCode() != mainSourceCode; ) {
-        auto e = v->getPath();
-        if(v->getCode() != mainSourceCode && e == nullptr)
-            break;
-        double flow = e->getFlow();
-        e->setFlow(flow - f);
-        v = e->getOrig();
-    }
+DegradationCurve Graph::pipelineDegradation(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional,
+                                            vector<double> levels, const vector<uint32_t> &sites) {
+    return getMaxFlowSolver()->maxFlowWithDegradedEdge(this, servicePointA, servicePointB, unidirectional,
+                                                       std::move(levels), sites);
 }
@@ -6,17 +6,21 @@
 #include <vector>
 #include <queue>
 #include <limits>
+#include <cstdint>
 #include <algorithm>
 #include <unordered_map>
 #include "WaterReservoir.h"
 #include "DeliverySite.h"
 #include "GraphMetrics.h"
+#include "Arena.h"
 
 using namespace std;
 
 class Edge;
+class MaxFlowSolver;
 
 #define INF std::numeric_limits<double>::max()
+#define NO_VERTEX std::numeric_limits<uint32_t>::max()
 
 /************************* Vertex  **************************/
 
@@ -29,6 +33,7 @@ enum class VertexType { WaterReservoir, PumpingStation, DeliverySite, MainSource
 */
 class Vertex {
 private:
+    uint32_t id;            // dense id of the node
     string code;            // code of the node
     VertexType type;        // type of the node
     vector<Edge *> adj;  // outgoing edges
@@ -47,10 +52,11 @@ public:
     /**
      * @brief Constructor forS Vertex class.
      *
+     * @param id The dense id assigned to the vertex.
      * @param code The code associated with the vertex.
      * @param type The type of the vertex.
      */
-    Vertex(string code, VertexType type);
+    Vertex(uint32_t id, string code, VertexType type);
 
     /**
      * @brief Less-than comparison operator for vertices based on distance.
@@ -60,12 +66,19 @@ public:
      */
     bool operator<(Vertex & vertex) const;
 
+    /**
+     * @brief Get the dense id of the vertex.
+     *
+     * @return The id of the vertex, which is also its index in the graph's vertex set.
+     */
+    [[nodiscard]] uint32_t getId() const;
+
     /**
      * @brief Get the code associated with the vertex.
      *
      * @return The code of the vertex.
      */
-    [[nodiscard]] string getCode() const;
+    [[nodiscard]] const string &getCode() const;
 
     /**
      * @brief Get the type of the vertex.
@@ -77,9 +90,12 @@ public:
     /**
      * @brief Get the adjacent edges of the vertex.
      *
-     * @return Vector of pointers to adjacent edges.
+     * @details The edges are returned by reference, so traversals do not copy the adjacency list. The reference
+     * is invalidated when edges are added to or removed from the vertex.
+     *
+     * @return Read-only view of the pointers to adjacent edges.
      */
-    [[nodiscard]] vector<Edge *> getAdj() const;
+    [[nodiscard]] const vector<Edge *> &getAdj() const;
 
     /**
      * @brief Check if the vertex has been visited.
@@ -98,9 +114,12 @@ public:
     /**
      * @brief Get the incoming edges of the vertex.
      *
-     * @return Vector of pointers to incoming edges.
+     * @details The edges are returned by reference, so traversals do not copy the incoming list. The reference
+     * is invalidated when edges are added to or removed from the vertex.
+     *
+     * @return Read-only view of the pointers to incoming edges.
      */
-    [[nodiscard]] vector<Edge *> getIncoming() const;
+    [[nodiscard]] const vector<Edge *> &getIncoming() const;
 
     /**
      * @brief Get the flow value associated with the vertex.
@@ -149,13 +168,16 @@ public:
     /**
      * @brief Add an edge between this vertex and a destination vertex.
      *
+     * @details The edge is created in 'edges', which owns it.
+     *
+     * @param edges The arena where the edge is created.
      * @param dest Pointer to the destination vertex.
      * @param c Capacity of the edge.
      * @param f Flow of the edge.
      *
      * @return Pointer to the newly added edge.
      */
-    Edge * addEdge(Vertex *dest, double c, double f = 0);
+    Edge * addEdge(Arena<Edge> &edges, Vertex *dest, double c, double f = 0);
 
     /**
      * @brief Find an edge between this vertex and a destination vertex.
@@ -165,6 +187,14 @@ public:
      * @return Pointer to the found edge if exists, otherwise nullptr.
      */
     Edge * findEdge(Vertex *destVertex);
+
+    /**
+     * @brief Reserves room for more outgoing and incoming edges.
+     *
+     * @param numOutgoing The number of outgoing edges about to be added.
+     * @param numIncoming The number of incoming edges about to be added.
+     */
+    void reserveEdges(size_t numOutgoing, size_t numIncoming);
 };
 
 /********************** Edge  ****************************/
@@ -251,36 +281,95 @@ public:
 
 /********************** Graph  ****************************/
 
+/**
+* @brief Pipe to be added to a graph by Graph::addEdges().
+*/
+struct EdgeSpec {
+    uint32_t source;
+    uint32_t dest;
+    double capacity;
+    bool bidirectional;
+};
+
+/**
+* @brief Flow state of a graph, saved by Graph::saveFlows() and restored by Graph::restoreFlows().
+*/
+struct FlowSnapshot {
+    vector<double> edgeFlows;
+    vector<double> vertexFlows;
+};
+
+/**
+* @brief Max flow of a graph while the capacity of one pipeline is scaled down, computed by Graph::pipelineDegradation().
+*
+* @details Scaling a single pipeline to a capacity t changes the capacity of the cuts that cross it by the same amount,
+* so the max flow is F(t) = min(F(c), F(0) + t) for t between 0 and the full capacity c: a piecewise-linear curve with
+* one breakpoint, given exactly by its two ends. The flow of the delivery sites is not unique, and is sampled at the
+* given levels.
+*/
+struct DegradationCurve {
+    double fullFlow = 0;            // max flow with the full capacity, F(c)
+    double failedFlow = 0;          // max flow without the pipeline, F(0)
+    vector<double> levels;          // fractions of the capacity left, in increasing order
+    vector<double> maxFlows;        // max flow at each level
+    vector<vector<double>> flows;   // flow of every delivery site at each level
+};
+
+/**
+* @brief Largest factor by which every demand can grow while still being met, computed by Graph::maxDemandGrowth().
+*/
+struct DemandGrowth {
+    double factor = 0;                          // largest factor found by the search
+    double upperBound = 0;                      // smallest factor known to be infeasible, or 'factor' if it is exact
+    unsigned int iterations = 0;                // number of runs of the max-flow solver
+    vector<pair<uint32_t, uint32_t>> cut;       // origin and destination of every edge of the limiting cut
+    vector<uint32_t> limitedSites;              // delivery sites behind the limiting cut
+};
+
 /**
 * @brief Class representing a graph.
+*
+* @details The graph owns its vertices and edges through two arenas, so they are laid out contiguously in creation
+* order and are all released together when the graph is destroyed. A graph cannot be copied.
 */
 class Graph {
 private:
-    unordered_map<string, Vertex *> vertices;    // vertex set
+    Arena<Vertex> vertexArena;                 // owns every vertex
+    Arena<Edge> edgeArena;                     // owns every edge
+    vector<Vertex *> vertices;                 // vertex set, indexed by vertex id
+    unordered_map<string, uint32_t> vertexIds; // interned vertex codes
     string mainSourceCode = "mainSource";
     string mainTargetCode = "mainTarget";
+    uint32_t mainSourceId = NO_VERTEX;
+    uint32_t mainTargetId = NO_VERTEX;
+    const MaxFlowSolver *solver = nullptr;     // nullptr selects the default solver
 
 public:
 
     /**
-     * @brief Creates a deep copy of the graph.
+     * @brief Saves the flow of every edge and vertex of the graph.
      *
-     * @details This function creates a new graph that is an exact copy of the original graph,
-     * including all vertices and edges. It iterates over all vertices in the original graph,
-     * copies them, and adds them to the new graph. Then, it iterates over all edges in the
-     * original graph, copies them along with their attributes, and adds them to the new graph.
-     * After copying, it updates the flow of all vertices in the new graph to match the original
-     * graph. Finally, it returns a pointer to the newly created graph.
+     * @details The topology of the graph is frozen once the network is loaded, so the flow state is saved as two
+     * plain arrays, the edge flows in adjacency order and the vertex flows in id order, instead of a copy of the
+     * vertices and edges. The vectors of 'snapshot' are reused, so saving into the same snapshot again does not
+     * allocate memory.
      *
-     * @return A pointer to the newly created copy of the graph.
+     * @param snapshot The snapshot where the flow state is saved.
      *
-     * @complexity The time complexity of this function depends on the number of vertices and edges
-     * in the original graph. Let V be the number of vertices and E be the number of edges in the
-     * original graph. The worst-case time complexity is O(E + V) due to the two loops iterating
-     * over vertices and edges, respectively. Additionally, updating the flow of vertices has a
-     * time complexity of O(V).
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
      */
-    Graph *copyGraph();
+    void saveFlows(FlowSnapshot &snapshot) const;
+
+    /**
+     * @brief Restores a flow state previously saved with saveFlows().
+     *
+     * @details The edges and vertices of the graph must not have changed since the snapshot was saved.
+     *
+     * @param snapshot The snapshot to be restored.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void restoreFlows(const FlowSnapshot &snapshot);
 
     /**
      * @brief Calculates various metrics for the graph based on delivery site flow data.
@@ -291,108 +380,136 @@ public:
      * It also determines the maximum flow and total demand in the graph. The calculated metrics are encapsulated in a GraphMetrics object
      * and returned.
      *
-     * @param deliverySites A pointer to an unordered map containing delivery site objects.
-     *
      * @return A GraphMetrics object containing various metrics calculated for the graph.
      *
      * @complexity The time complexity of this function depends on the number of edges in the graph.
      * Let, E be the total number of edges. The worst-case time complexity is O(V + E)
      * due to the nested loops iterating over vertices and edges.
      */
-    GraphMetrics calculateMetrics(const unordered_map<string, DeliverySite *> *deliverySites);
+    GraphMetrics calculateMetrics();
 
     /**
      * @brief Calculates the total demand and maximum flow in the graph.
      *
-     * @details This function iterates over all delivery sites in the provided unordered map and
+     * @details This function iterates over all delivery sites connected to the main target vertex and
      * calculates the total demand and maximum flow in the graph based on the flow values of the delivery
-     * sites. It sums up the demand of each delivery site to calculate the total demand and adds the flow
-     * of each delivery site to calculate the maximum flow. It returns a pair containing the total demand
-     * and maximum flow.
-     *
-     * @param deliverySites A pointer to an unordered map containing delivery site objects.
+     * sites. It sums up the demand of each delivery site (the capacity of its edge to the main target) to
+     * calculate the total demand and adds the flow of each delivery site to calculate the maximum flow.
+     * It returns a pair containing the total demand and maximum flow.
      *
      * @return A pair containing the total demand and maximum flow in the graph.
      *
-     * @complexity The time complexity of this function depends on the number of delivery sites in the
-     * provided unordered map. In the worst case, it iterates over all delivery sites once, resulting in
-     * a time complexity of O(n), where n is the number of delivery sites.
+     * @complexity The time complexity of this function depends on the number of delivery sites. In the worst
+     * case, it iterates over all delivery sites once, resulting in a time complexity of O(n), where n is the
+     * number of delivery sites.
      */
-    pair<double, double> getTotalDemandAndMaxFlow(const unordered_map<string, DeliverySite *> *deliverySites) const;
+    [[nodiscard]] pair<double, double> getTotalDemandAndMaxFlow() const;
 
     /**
-     * @brief Retrieves the code of the main source vertex in the graph.
+     * @brief Retrieves the id of the main source vertex in the graph.
      *
-     * @details This function returns the code of the main source vertex, which is a specific vertex
+     * @details This function returns the id of the main source vertex, which is a specific vertex
      * used in flow algorithms such as max flow.
      *
-     * @return The code of the main source vertex.
+     * @return The id of the main source vertex, or NO_VERTEX if it was not created yet.
      *
      * @complexity This function has a time complexity of O(1) as it performs a simple retrieval
      * operation.
      */
-    string getMainSourceCode();
+    [[nodiscard]] uint32_t getMainSourceId() const;
 
     /**
-     * @brief Retrieves the code of the main target vertex in the graph.
+     * @brief Retrieves the id of the main target vertex in the graph.
      *
-     * @details This function returns the code of the main target vertex, which is a specific vertex
+     * @details This function returns the id of the main target vertex, which is a specific vertex
      * used in flow algorithms such as max flow.
      *
-     * @return The code of the main target vertex.
+     * @return The id of the main target vertex, or NO_VERTEX if it was not created yet.
      *
      * @complexity This function has a time complexity of O(1) as it performs a simple retrieval
      * operation.
      */
-    string getMainTargetCode();
+    [[nodiscard]] uint32_t getMainTargetId() const;
 
     /**
-     * @brief Finds a vertex in the graph based on its code.
+     * @brief Retrieves the solver used to compute the maximum flow in the graph.
      *
-     * @details This function searches for a vertex with the given code in the graph's vertex set. If
-     * the vertex is found, a pointer to it is returned; otherwise, nullptr is returned to indicate that
-     * the vertex could not be found.
+     * @return The solver used by maxFlow and by the out of commission functions, which is the default solver
+     * of the MaxFlowSolverRegistry if none was set.
      *
-     * @param code The code of the vertex to be found.
+     * @complexity O(1).
+     */
+    [[nodiscard]] const MaxFlowSolver *getMaxFlowSolver() const;
+
+    /**
+     * @brief Sets the solver used to compute the maximum flow in the graph.
+     *
+     * @details Every solver supports the same deactivated vertex and deactivated pipeline semantics, so the
+     * choice only affects the running time and, when the maximum flow is not unique, how it is distributed.
+     *
+     * @param maxFlowSolver The solver to be used by maxFlow and by the out of commission functions, or nullptr
+     * to use the default solver.
+     *
+     * @complexity O(1).
+     */
+    void setMaxFlowSolver(const MaxFlowSolver *maxFlowSolver);
+
+    /**
+     * @brief Finds a vertex in the graph based on its id.
+     *
+     * @param id The id of the vertex to be found.
      *
      * @return A pointer to the vertex if found, nullptr otherwise.
      *
+     * @complexity O(1), as the vertex set is indexed by id.
+     */
+    [[nodiscard]] Vertex *findVertex(uint32_t id) const;
+
+    /**
+     * @brief Finds the id of a vertex in the graph based on its code.
+     *
+     * @details This function looks up the given code in the table of interned vertex codes. It is meant
+     * to be used only where codes enter the program (files and console input); everything else works on ids.
+     *
+     * @param code The code of the vertex to be found.
+     *
+     * @return The id of the vertex if found, NO_VERTEX otherwise.
+     *
      * @complexity The time complexity of this function depends on the time complexity of finding an
-     * element in an unordered_map, which is O(1) in the worst case.
+     * element in an unordered_map, which is O(1) in the average case.
      */
-    Vertex *findVertex(const string &code) const;
+    [[nodiscard]] uint32_t findVertexId(const string &code) const;
 
     /**
-     * @brief Adds a vertex to the graph.
+     * @brief Adds a vertex to the graph, interning its code.
      *
-     * @details This function adds a vertex with the given code and type to the graph. If a vertex with
-     * the same code already exists in the graph, the function returns false, indicating that the vertex
-     * could not be added. Otherwise, it creates a new vertex, inserts it into the graph's vertex set,
-     * and returns true to indicate a successful addition.
+     * @details This function adds a vertex with the given code and type to the graph, assigning it the
+     * next dense id. If a vertex with the same code already exists in the graph, no vertex is added and
+     * the id of the existing vertex is returned.
      *
      * @param code The code of the vertex to be added.
      * @param type The type of the vertex to be added.
      *
-     * @return True if the vertex is successfully added, false otherwise.
+     * @return The id of the vertex with the given code.
      *
      * @complexity The time complexity of this function depends on the time complexity of finding a
-     * vertex in the graph, which is O(1) in the worst case, and inserting a new vertex into
-     * the vertex set, which is also O(1) in the worst case.
+     * code in the table of interned codes, which is O(1) in the average case, and appending a new vertex
+     * to the vertex set, which is O(1) amortized.
      */
-    bool addVertex(const string &code, const VertexType &type);
+    uint32_t addVertex(const string &code, const VertexType &type);
 
     /**
      * @brief Adds an edge between two vertices in the graph.
      *
-     * @details This function adds an edge from the vertex with the source code to the vertex with the
-     * destination code. If either of the vertices does not exist in the graph, the function returns
+     * @details This function adds an edge from the vertex with the source id to the vertex with the
+     * destination id. If either of the vertices does not exist in the graph, the function returns
      * false, indicating that the edge could not be added. Otherwise, it adds the edge to the origin
      * vertex and checks if there is a corresponding reverse edge in the destination vertex. If a
      * reverse edge exists and has the same capacity as the newly added edge, it sets the reverse
      * pointers for both edges to maintain bidirectionality.
      *
-     * @param source The code of the source vertex.
-     * @param dest The code of the destination vertex.
+     * @param source The id of the source vertex.
+     * @param dest The id of the destination vertex.
      * @param c The capacity of the edge.
      * @param f The flow through the edge from source to dest.
      *
@@ -402,19 +519,19 @@ public:
      * vertices in the graph, adding edges to the vertices, and setting reverse pointers, all of which
      * are O(1) in the worst case.
      */
-    bool addEdge(const string &source, const string &dest, double c, double f = 0) const;
+    bool addEdge(uint32_t source, uint32_t dest, double c, double f = 0);
 
     /**
      * @brief Adds a bidirectional edge between two vertices in the graph.
      *
      * @details This function adds a bidirectional edge between the vertices with the given source and
-     * destination codes. If either of the vertices does not exist in the graph, the function returns
+     * destination ids. If either of the vertices does not exist in the graph, the function returns
      * false, indicating that the edge could not be added. Otherwise, it creates two edges: one from
      * source to dest and another from dest to source, each with the specified capacity and flow.
      * Additionally, it sets the reverse pointers for the edges to maintain bidirectionality.
      *
-     * @param source The code of the source vertex.
-     * @param dest The code of the destination vertex.
+     * @param source The id of the source vertex.
+     * @param dest The id of the destination vertex.
      * @param c The capacity of the edge.
      * @param flow The flow through the edge from source to dest.
      * @param reverseFlow The flow through the reverse edge from dest to source.
@@ -425,20 +542,87 @@ public:
      * vertices in the graph, adding edges to the vertices, and setting reverse pointers, all of which
      * are O(1) in the worst case.
      */
-    bool addBidirectionalEdge(const string &source, const string &dest, double c, double flow = 0, double reverseFlow = 0) const;
+    bool addBidirectionalEdge(uint32_t source, uint32_t dest, double c, double flow = 0, double reverseFlow = 0);
+
+    /**
+     * @brief Adds many edges at once.
+     *
+     * @details The degree of every vertex is counted first, so each adjacency and incoming list grows once. The edges
+     * are then added in the given order, with addBidirectionalEdge() or addEdge(), so the graph is the same as if they
+     * had been added one by one. Edges with a missing vertex are skipped.
+     *
+     * @param edges The edges to be added.
+     *
+     * @complexity O(V + E * d), where V is the number of vertices, E is the number of edges and d is the largest
+     * number of edges leaving a vertex, which addEdge() scans for a reverse edge.
+     */
+    void addEdges(const vector<EdgeSpec> &edges);
 
     /**
      * @brief Retrieves the set of vertices in the graph.
      *
-     * @return An unordered map containing the vertices of the graph, where the keys are vertex codes
-     * and the values are pointers to the corresponding vertices.
+     * @return Read-only view of the contiguous vector of pointers to the vertices of the graph, where the
+     * position of each vertex is its id.
+     *
+     * @details This function returns a reference to the vector containing all vertices in the graph, so
+     * iterating over the vertices does not allocate. The reference is invalidated when vertices are added.
+     *
+     * @complexity O(1)
+     */
+    [[nodiscard]] const vector<Vertex *> &getVertexSet() const;
+
+    /**
+     * @brief Retrieves the number of edges in the graph.
+     *
+     * @return The number of edges, including the edges of the main source and main target.
+     *
+     * @complexity O(1)
+     */
+    [[nodiscard]] size_t getNumEdges() const;
+
+    /**
+     * @brief Retrieves an edge by its position in creation order.
+     *
+     * @details Adding the edges again in creation order, with the same reverse pointers, rebuilds the same adjacency
+     * and incoming lists, so the max-flow solvers visit the arcs in the same order.
+     *
+     * @param i The position of the edge, less than getNumEdges().
+     *
+     * @return Pointer to the edge.
+     *
+     * @complexity O(1)
+     */
+    [[nodiscard]] Edge *getEdge(size_t i) const;
+
+    /**
+     * @brief Adds an edge between two vertices, without looking for a reverse edge.
+     *
+     * @details Unlike addEdge(), the reverse pointer of the new edge is left for the caller to set, which is how a
+     * graph saved edge by edge is rebuilt exactly.
      *
-     * @details This function returns a copy of the unordered map containing all vertices in the graph.
-     * It does not modify the original graph.
+     * @param source The id of the source vertex, which must exist.
+     * @param dest The id of the destination vertex, which must exist.
+     * @param c The capacity of the edge.
+     * @param f The flow through the edge.
+     *
+     * @return Pointer to the new edge.
+     *
+     * @complexity O(1) amortized.
+     */
+    Edge *addUnpairedEdge(uint32_t source, uint32_t dest, double c, double f);
+
+    /**
+     * @brief Marks existing vertices as the main source and main target of the graph.
+     *
+     * @details This function is used when the main source and main target are restored with the rest of a saved
+     * graph, instead of being created by maxFlow().
+     *
+     * @param source The id of the main source vertex.
+     * @param target The id of the main target vertex.
      *
      * @complexity O(1)
      */
-    unordered_map<string, Vertex *> getVertexSet() const;
+    void setMainVertices(uint32_t source, uint32_t target);
 
     /**
      * @brief Sets the flow value of all edges in the graph to a specified value.
@@ -516,27 +700,39 @@ public:
     void createMainTarget(const unordered_map<string, DeliverySite *> *deliverySites);
 
     /**
-     * @brief Computes the maximum flow in the graph using the Edmonds-Karp algorithm.
+     * @brief Computes the maximum flow in the graph using the selected max-flow algorithm.
      *
-     * @details This function computes the maximum flow in the graph using the Edmonds-Karp algorithm.
-     * It first creates the main source and main target vertices based on the provided water reservoirs
-     * and delivery sites. Then, it initializes the flow of all edges and vertices to zero. Finally, it
-     * applies the Edmonds-Karp algorithm to compute the maximum flow.
+     * @details This function computes the maximum flow in the graph using the selected max-flow algorithm
+     * (Edmonds-Karp by default). It first creates the main source and main target vertices based on the provided
+     * water reservoirs and delivery sites. Then, it initializes the flow of all edges and vertices to zero.
+     * Finally, it applies the max-flow algorithm to compute the maximum flow.
      *
      * @param waterReservoirs A pointer to the unordered map containing water reservoir data.
      * @param deliverySites A pointer to the unordered map containing delivery site data.
      *
-     * @complexity The time complexity of this function depends on the implementation of the Edmonds-Karp
-     * algorithm, which has a worst-case time complexity of O(V * E^2), where V is the number of vertices
+     * @complexity The time complexity of this function depends on the selected max-flow solver. The default
+     * Edmonds-Karp algorithm has a worst-case time complexity of O(V * E^2), where V is the number of vertices
      * and E is the number of edges in the graph.
      */
     void maxFlow(const unordered_map<string, WaterReservoir *> *waterReservoirs, const unordered_map<string, DeliverySite *> *deliverySites);
 
+    /**
+     * @brief Runs the selected max-flow solver on the graph.
+     *
+     * @details This function continues from the current flow of the graph, runs the solver selected
+     * with setMaxFlowSolver until no more flow can be sent from the main source to the main target,
+     * and saves the incoming flow of every vertex.
+     *
+     * @complexity The complexity of the selected solver: O(V * E^2) with Edmonds-Karp, O(V^2 * E) with Dinic
+     * and O(V^2 * sqrt(E)) with push-relabel, where V is the number of vertices and E is the number of edges.
+     */
+    void runMaxFlow();
+
     /**
      * @brief Optimizes the load distribution in the graph to improve flow characteristics.
      *
      * @details This function optimizes the load distribution in the graph to improve flow characteristics.
-     * It calculates the initial metrics of the graph using the provided delivery sites, initializes the final metrics
+     * It calculates the initial metrics of the graph, initializes the final metrics
      * to be the same as the initial metrics, and retrieves all edges in the graph. Then, it iteratively performs load
      * optimization until convergence criteria are met or the maximum number of iterations is reached. In each iteration,
      * it sorts the edges based on the difference between capacity and flow, and then for each edge, it finds paths
@@ -545,13 +741,11 @@ public:
      * for convergence. The optimization process continues until convergence criteria are met or the maximum number
      * of iterations is reached. Finally, it updates the flow values of all vertices in the graph.
      *
-     * @param deliverySites Pointer to the unordered map containing delivery sites information.
-     *
      * @complexity The time complexity of this function depends on the number of edges in the graph, the number of
      * delivery sites, and the efficiency of the path-finding algorithm. Let V be the number of vertices and E be
      * the number of edges. The worst-case time complexity is O(n(E * (V + E))), where n is the number of iterations.
      */
-    void optimizeLoad(const unordered_map<string, DeliverySite *> *deliverySites);
+    void optimizeLoad();
 
     /**
      * @brief Finds all paths from a source vertex to a destination vertex in the graph.
@@ -561,8 +755,8 @@ public:
      * representing the current path and marks all vertices as unvisited. Next, it invokes the depth-first search (DFS)
      * algorithm to explore paths from the source to the destination. Finally, it returns the vector of paths found.
      *
-     * @param source The code of the source vertex.
-     * @param dest The code of the destination vertex.
+     * @param source The id of the source vertex.
+     * @param dest The id of the destination vertex.
      * @return A vector of vectors of edges representing all paths from the source to the destination.
      *
      * @complexity The time complexity of this function depends on the size and structure of the graph, as well as
@@ -571,7 +765,7 @@ public:
      * However, in practice, it often performs efficiently, especially if the graph is sparse or there are a limited number
      * of paths from the source to the destination.
      */
-    vector<vector<Edge *>> getPaths(const string& source, const string &dest);
+    vector<vector<Edge *>> getPaths(uint32_t source, uint32_t dest);
 
     /**
      * @brief Performs depth-first search (DFS) to find paths from a source vertex to a destination vertex in the graph.
@@ -583,112 +777,90 @@ public:
      * vertices that have available capacity for flow. This function is used to find all possible paths from a source
      * to a destination in the graph.
      *
-     * @param current The code of the current vertex being visited.
-     * @param dest The code of the destination vertex.
+     * @param current The id of the current vertex being visited.
+     * @param dest The id of the destination vertex.
      * @param path The vector of edges representing the current path being explored.
      * @param paths The vector of vectors of edges representing all found paths from the source to the destination.
      *
      * @complexity A DFS has a time complexity of O(V+E). Where V is the number of vertices and E is the number of edges.
      */
-    void dfs(const string &current, const string &dest, vector<Edge *> &path, vector<vector<Edge *>> &paths);
+    void dfs(uint32_t current, uint32_t dest, vector<Edge *> &path, vector<vector<Edge *>> &paths);
 
     /**
      * @brief Marks a pumping station or reservoir as out of commission and adjusts the flow in the graph.
      *
-     * @details This function marks a pumping station or reservoir as out of commission by deactivating
-     * the corresponding vertex and adjusts the flow in the graph. It first runs the Edmonds-Karp algorithm
-     * to find the maximum flow in the graph. Then, it deactivates the vertex corresponding to the provided code.
-     * After deactivating the vertex, it recalculates the maximum flow in the graph using the Edmonds-Karp algorithm
-     * with the deactivated vertex. Finally, it updates the flow values of all vertices in the graph.
+     * @details This function marks a pumping station or reservoir as out of commission starting from the max flow
+     * currently stored in the graph. It cancels only the flow routed through the corresponding vertex, deactivates
+     * it, and lets the selected max-flow solver re-route the lost flow around it, without solving the whole network
+     * again. Finally, it updates the flow values of all vertices in the graph.
      *
-     * @param code Pointer to the code of the pumping station or reservoir to be deactivated.
+     * @param id The id of the pumping station or reservoir to be deactivated.
      *
-     * @complexity The time complexity of this function depends on the size and structure of the graph,
-     * as well as the efficiency of the Edmonds-Karp algorithm. In the worst case, where the graph is dense
-     * and the Edmonds-Karp algorithm has to run multiple times, the time complexity can be O(V * (E^2)), where V
-     * is the number of vertices and E is the number of edges. However, in practice, it performs efficiently,
-     * because it does not execute the Edmonds-Karp from the beginning.
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the vertex, plus the complexity of the selected
+     * max-flow solver to re-route the lost flow, where V is the number of vertices and E is the number of edges.
+     * In practice the repair is local, since only the lost flow has to be augmented again.
      */
-    void stationOutOfCommission(string const *code);
+    void stationOutOfCommission(uint32_t id);
 
     /**
      * @brief Marks a pipeline between two service points as out of commission and adjusts the flow in the graph.
      *
-     * @details This function marks a pipeline between two service points as out of commission by deactivating
-     * the corresponding vertices and and adjusts the flow in the graph. Then, it deactivates the vertex corresponding
-     * to the origin service point. If the pipeline is bidirectional, it also deactivates the vertex corresponding to
-     * the destination service point. After deactivating the vertices, it recalculates the maximum flow in the graph
-     * using the Edmonds-Karp algorithm with the deactivated edges. Finally, it updates the flow values of all vertices in the graph.
+     * @details This function marks a pipeline between two service points as out of commission starting from the max
+     * flow currently stored in the graph. It cancels only the flow routed through the edges of the pipeline (in both
+     * directions if the pipeline is bidirectional), deactivates them, and lets the selected max-flow solver re-route
+     * the lost flow around them, without solving the whole network again. Finally, it updates the flow values of all
+     * vertices in the graph.
      *
-     * @param servicePointA Pointer to the code of the first service point.
-     * @param servicePointB Pointer to the code of the second service point.
+     * @param servicePointA The id of the first service point.
+     * @param servicePointB The id of the second service point.
      * @param unidirectional Indicates whether the pipeline is unidirectional (true) or bidirectional (false).
      *
-     * @complexity The time complexity of this function depends on the size and structure of the graph,
-     * as well as the efficiency of the Edmonds-Karp algorithm. In the worst case, where the graph is dense
-     * and the Edmonds-Karp algorithm has to run multiple times, the time complexity can be O(V * (E^2)), where V
-     * is the number of vertices and E is the number of edges. However, in practice, it performs efficiently,
-     * because it does not execute the Edmonds-Karp from the beginning.
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the pipeline, plus the complexity of the selected
+     * max-flow solver to re-route the lost flow, where V is the number of vertices and E is the number of edges.
+     * In practice the repair is local, since only the lost flow has to be augmented again.
      */
-    void pipelineOutOfCommission(string const *servicePointA, string const *servicePointB, bool unidirectional);
+    void pipelineOutOfCommission(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional);
 
     /**
-     * @brief Deactivates a vertex and adjusts the flow in the graph.
-     *
-     * @details This function deactivates a vertex and adjusts the flow in the graph.
-     * It iteratively checks for flow cycles involving the deactivated vertex and deactivates them by reducing
-     * the flow along the cycle. If no flow cycles are detected, it finds and deactivates flow paths originating
-     * from the deactivated vertex. This process continues until the deactivated vertex has no more flow.
+     * @brief Computes the max flow of the graph while the capacity of a pipeline degrades down to zero.
      *
-     * @param deactivatedVertex The vertex to deactivate.
+     * @details This function starts from the max flow currently stored in the graph, which has the pipeline at full
+     * capacity, and follows the same path as pipelineOutOfCommission() to remove it. The capacity is then raised back
+     * level by level, and every level only augments the flow added by its increment, so the whole curve costs about
+     * as much as a single failure. The flow of the graph is not changed.
      *
-     * @complexity The time complexity of this function depends on the size and structure of the graph, as well as the
-     * number of flow cycles and flow paths involving the deactivated vertex. In the worst case, where the deactivated
-     * vertex has flow connected to all other vertices in the graph, and there are many flow cycles and paths, the
-     * function's time complexity can be O(V * (E^2)), where V is the number of vertices and E is the number of edges.
-     * However, in practice, it often performs efficiently since it terminates once the deactivated vertex has no more flow.
-     */
-    void deactivateVertex(Vertex *v);
-
-    /**
-     * @brief Detects and deactivates flow cycles originating from a specified vertex.
-     *
-     * @details This function detects and deactivates flow cycles in the graph originating from the specified vertex.
-     * It performs a breadth-first search (BFS) starting from the deactivated vertex to identify cycles with positive
-     * flow. If a cycle is found, it deactivates the flow along the cycle by updating the flow values of the edges.
-     * The function returns true if a cycle is detected and deactivated; otherwise, it returns false.
-     *
-     * @param deactivatedVertex The vertex from which to start detecting flow cycles.
+     * @param servicePointA The id of the first service point.
+     * @param servicePointB The id of the second service point.
+     * @param unidirectional Indicates whether the pipeline is unidirectional (true) or bidirectional (false).
+     * @param levels The fractions of the capacity to be sampled, between 0 and 1.
+     * @param sites The vertex ids of the delivery sites whose flow is sampled.
      *
-     * @return True if a flow cycle is detected and deactivated, false otherwise.
+     * @return The max-flow curve of the pipeline.
      *
-     * @complexity The time complexity of this function depends on the size of the graph and the presence of flow
-     * cycles. In the worst case, where there are flow cycles originating from the deactivated vertex, the function
-     * performs a BFS traversal, which has a time complexity of O(V + E), where V is the number of vertices and E is
-     * the number of edges in the graph. Additionally, the function updates flow values along the cycle, which adds
-     * additional time complexity proportional to the number of edges in the cycle.
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the pipeline, plus the complexity of the selected
+     * max-flow solver for the failure and for each of the L levels, where V is the number of vertices and E is the
+     * number of edges. Each level only augments the flow of its capacity increment.
      */
-    bool detectAndDeactivateFlowCycles(Vertex *deactivatedVertex);
+    DegradationCurve pipelineDegradation(uint32_t servicePointA, uint32_t servicePointB, bool unidirectional,
+                                         vector<double> levels, const vector<uint32_t> &sites);
 
     /**
-     * @brief Finds and deactivates a flow path originating from a specified vertex.
+     * @brief Finds the largest factor by which the demand of every delivery site can grow while still being met.
+     *
+     * @details This function searches the factor by bisection over the capacities of the edges into the main target,
+     * which hold the demands, without rebuilding the graph. Raising the demands never makes a flow infeasible, so every
+     * step starts from the flow of the largest factor found to be feasible so far, and only augments the extra demand.
+     * The limiting cut is the minimum cut at the smallest factor found to be infeasible, without the edges into the
+     * main target. The flow of the graph is not changed.
      *
-     * @details This function finds and deactivates a flow path in the graph originating from the specified vertex.
-     * It first performs a BFS traversal from the deactivated vertex to find a path to the main target vertex. Then,
-     * it performs another BFS traversal from the main source vertex to the deactivated vertex. Finally, it identifies
-     * the common path between the two traversals and deactivates the flow along this path. The function updates the
-     * flow values of the edges along the path to reduce the flow. If no path is found or the path has no positive flow,
-     * no action is taken.
+     * @param tolerance The largest gap between the factor found and the exact one, relative to the exact one.
      *
-     * @param deactivatedVertex The vertex from which to start searching for a flow path.
+     * @return The growth factor, its upper bound and the limiting cut.
      *
-     * @complexity The time complexity of this function depends on the size of the graph and the length of the flow path
-     * from the deactivated vertex to the main target vertex. In the worst case, where the flow path covers the entire
-     * graph, the function performs two BFS traversals, each with a time complexity of O(V + E), where V is the number
-     * of vertices and E is the number of edges in the graph. Additionally, the function updates flow values along the
-     * identified path, which adds additional time complexity proportional to the number of edges in the path.
+     * @complexity O(log(1 / tolerance)) runs of the selected max-flow solver, each only augmenting the flow added by
+     * the growth of the demands.
      */
-    void findAndDeactivateFlowPath(Vertex *deactivatedVertex);
+    DemandGrowth maxDemandGrowth(double tolerance);
 };
 
 #endif //WATER_SUPPLY_ANALYSIS_SYSTEM_GRAPH_H
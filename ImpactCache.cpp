@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "ImpactCache.h"
+
+uint64_t ImpactCache::hash(const char *data, size_t size, uint64_t hash) {
+    for(size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char) data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+void ImpactCache::open(const filesystem::path &cachePath, uint64_t networkFingerprint, vector<string> siteCodes) {
+    path = cachePath;
+    fingerprint = networkFingerprint;
+    sites = std::move(siteCodes);
+    entries.clear();
+    dirty = false;
+    load();
+}
+
+void ImpactCache::load() {
+    ifstream file(path);
+    if(!file.is_open()) return;
+
+    string line;
+    if(!getline(file, line)) return;
+
+    stringstream expected;
+    expected << MAGIC << " " << hex << setw(16) << setfill('0') << fingerprint;
+    if(line != expected.str()) return;
+
+    // Map every column of the file to the delivery site it belongs to
+    if(!getline(file, line)) return;
+    stringstream header(line);
+    string column;
+    getline(header, column, ',');
+    getline(header, column, ',');
+
+    unordered_map<string, size_t> siteIndex;
+    for(size_t i = 0; i < sites.size(); i++) siteIndex[sites[i]] = i;
+
+    vector<size_t> columnSite;
+    while(getline(header, column, ',')) {
+        auto it = siteIndex.find(column);
+        if(it == siteIndex.end()) return;
+        columnSite.push_back(it->second);
+    }
+    if(columnSite.size() != sites.size()) return;
+
+    while(getline(file, line)) {
+        stringstream entry(line);
+        string failureSet, value;
+        FailureResult result;
+        result.flows.assign(sites.size(), 0);
+
+        if(!getline(entry, failureSet, ',') || !getline(entry, value, ',')) return;
+
+        try {
+            result.maxFlow = stod(value);
+            for(size_t site : columnSite) {
+                if(!getline(entry, value, ',')) return;
+                result.flows[site] = stod(value);
+            }
+        } catch (const exception &e) {
+            // A damaged file is dropped, the entries read so far are still valid
+            return;
+        }
+        entries[failureSet] = std::move(result);
+    }
+}
+
+bool ImpactCache::find(const string &failureSet, FailureResult &result) const {
+    auto it = entries.find(failureSet);
+    if(it == entries.end()) return false;
+
+    result = it->second;
+    return true;
+}
+
+void ImpactCache::insert(const string &failureSet, const FailureResult &result) {
+    entries[failureSet] = result;
+    dirty = true;
+}
+
+bool ImpactCache::save() {
+    if(!dirty) return true;
+    if(path.empty()) return false;
+
+    error_code error;
+    filesystem::create_directories(path.parent_path(), error);
+
+    filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        ofstream file(tempPath);
+        if(!file.is_open()) return false;
+
+        file << MAGIC << " " << hex << setw(16) << setfill('0') << fingerprint << dec << endl;
+
+        file << "Failure Set,Max Flow";
+        for(const string &site : sites) file << "," << site;
+        file << endl;
+
+        // Sorted, so the same entries always give the same file
+        vector<const pair<const string, FailureResult> *> sorted;
+        sorted.reserve(entries.size());
+        for(const auto &entry : entries) sorted.push_back(&entry);
+        sort(sorted.begin(), sorted.end(), [](auto *a, auto *b) { return a->first < b->first; });
+
+        // 17 significant digits read back to the same double
+        file << setprecision(17);
+        for(const auto *entry : sorted) {
+            file << entry->first << "," << entry->second.maxFlow;
+            for(double flow : entry->second.flows) file << "," << flow;
+            file << endl;
+        }
+
+        if(!file) return false;
+    }
+
+    filesystem::rename(tempPath, path, error);
+    if(error) return false;
+
+    dirty = false;
+    return true;
+}
@@ -0,0 +1,108 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_IMPACT_CACHE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_IMPACT_CACHE_H
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "FailureSweep.h"
+
+using namespace std;
+
+/**
+* @brief Persistent cache of the results of failure impact queries.
+*
+* @details Every entry maps a failure set, the codes of the components out of commission, to the max flow and the flow
+* of every delivery site with those components out of commission. The cache belongs to one network fingerprint, a
+* content hash of everything the results depend on: the bytes of the input files and the max-flow solver. The cache file
+* starts with the fingerprint it was written for, so a file written for other inputs is discarded when it is opened, and
+* replaced the next time the cache is saved.
+*
+* The file is a CSV with one line per failure set, whose columns are the delivery sites, so it can be read back whatever
+* the order the delivery sites end up in. The flows are written with enough digits to be read back exactly, so a cached
+* result is indistinguishable from a computed one.
+*/
+class ImpactCache {
+private:
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+    static constexpr const char *MAGIC = "# water supply impact cache v2";
+
+    filesystem::path path;
+    uint64_t fingerprint = 0;
+    vector<string> sites;
+    unordered_map<string, FailureResult> entries;
+    bool dirty = false;
+
+    /**
+     * @brief Reads the entries of the cache file, if it was written for the current fingerprint and delivery sites.
+     *
+     * @complexity O(n * s), where n is the number of entries and s is the number of delivery sites.
+     */
+    void load();
+
+public:
+
+    /**
+     * @brief Hashes a sequence of bytes with 64-bit FNV-1a.
+     *
+     * @param data The bytes.
+     * @param size The number of bytes.
+     * @param hash The hash to continue from, so several sequences can be hashed as one.
+     *
+     * @return The hash.
+     *
+     * @complexity O(size).
+     */
+    static uint64_t hash(const char *data, size_t size, uint64_t hash = FNV_OFFSET);
+
+    /**
+     * @brief Opens the cache of a network, dropping the entries of the network opened before.
+     *
+     * @param cachePath The path of the cache file.
+     * @param networkFingerprint The fingerprint of the network.
+     * @param siteCodes The codes of the delivery sites, in the order of the flows of the results.
+     *
+     * @complexity O(n * s), where n is the number of entries and s is the number of delivery sites.
+     */
+    void open(const filesystem::path &cachePath, uint64_t networkFingerprint, vector<string> siteCodes);
+
+    /**
+     * @brief Looks up the result of a failure set.
+     *
+     * @param failureSet The codes of the components out of commission, joined by " + ".
+     * @param result The result, only set when the failure set is cached.
+     *
+     * @return True if the failure set is cached, false otherwise.
+     *
+     * @complexity O(s) on average, where s is the number of delivery sites.
+     */
+    bool find(const string &failureSet, FailureResult &result) const;
+
+    /**
+     * @brief Adds the result of a failure set to the cache.
+     *
+     * @param failureSet The codes of the components out of commission, joined by " + ".
+     * @param result The result, with the flows in the order of the delivery sites the cache was opened with.
+     *
+     * @complexity O(s) on average, where s is the number of delivery sites.
+     */
+    void insert(const string &failureSet, const FailureResult &result);
+
+    /**
+     * @brief Writes the cache file, if entries were added since it was opened or last saved.
+     *
+     * @details The file is written next to its final path and renamed over it, so a cache file is never left half
+     * written. The cache only saves work, so a failure to write it is not an error and leaves the entries in memory.
+     *
+     * @return True if the cache file is up to date, false otherwise.
+     *
+     * @complexity O(n * s), where n is the number of entries and s is the number of delivery sites.
+     */
+    bool save();
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_IMPACT_CACHE_H
@@ -0,0 +1,130 @@
+#include <fstream>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "ImpactMatrix.h"
+
+ImpactMatrix::ImpactMatrix(vector<string> components, vector<string> sites, const vector<double> &baseline,
+                           const vector<FailureResult> &results)
+        : components(std::move(components)), sites(std::move(sites)) {
+    size_t n = this->components.size();
+    size_t s = this->sites.size();
+
+    this->baseline = baseline;
+    flows.resize(n * s);
+
+    for(size_t k = 0; k < n; k++) {
+        for(size_t c = 0; c < s; c++) flows[c * n + k] = results[k].flows[c];
+    }
+}
+
+size_t ImpactMatrix::getNumComponents() const {
+    return components.size();
+}
+
+size_t ImpactMatrix::getNumSites() const {
+    return sites.size();
+}
+
+const string &ImpactMatrix::getComponent(size_t component) const {
+    return components[component];
+}
+
+const string &ImpactMatrix::getSite(size_t site) const {
+    return sites[site];
+}
+
+double ImpactMatrix::getBaseline(size_t site) const {
+    return baseline[site];
+}
+
+double ImpactMatrix::getFlow(size_t component, size_t site) const {
+    return flows[site * components.size() + component];
+}
+
+vector<double> ImpactMatrix::getDeltas() const {
+    size_t n = components.size();
+    vector<double> deltas(flows.size());
+
+    for(size_t c = 0; c < sites.size(); c++) {
+        const double *column = &flows[c * n];
+        double *delta = &deltas[c * n];
+        size_t k = 0;
+#ifdef __SSE2__
+        __m128d base = _mm_set1_pd(baseline[c]);
+        for(; k + 2 <= n; k += 2) _mm_storeu_pd(delta + k, _mm_sub_pd(base, _mm_loadu_pd(column + k)));
+#endif
+        for(; k < n; k++) delta[k] = baseline[c] - column[k];
+    }
+    return deltas;
+}
+
+vector<double> ImpactMatrix::getTotalLoss() const {
+    size_t n = components.size();
+    vector<double> loss(n, 0);
+
+    // Adding column by column keeps every access contiguous
+    for(size_t c = 0; c < sites.size(); c++) {
+        const double *column = &flows[c * n];
+        size_t k = 0;
+#ifdef __SSE2__
+        __m128d base = _mm_set1_pd(baseline[c]);
+        for(; k + 2 <= n; k += 2) {
+            __m128d delta = _mm_sub_pd(base, _mm_loadu_pd(column + k));
+            _mm_storeu_pd(&loss[k], _mm_add_pd(_mm_loadu_pd(&loss[k]), delta));
+        }
+#endif
+        for(; k < n; k++) loss[k] += baseline[c] - column[k];
+    }
+    return loss;
+}
+
+vector<WorstCase> ImpactMatrix::getWorstCases() const {
+    size_t n = components.size();
+    vector<WorstCase> worst(sites.size());
+
+    for(size_t c = 0; c < sites.size(); c++) {
+        const double *column = &flows[c * n];
+
+        // The largest loss is the smallest flow of the column
+        double minFlow = baseline[c];
+        size_t k = 0;
+#ifdef __SSE2__
+        __m128d minimum = _mm_set1_pd(minFlow);
+        for(; k + 2 <= n; k += 2) minimum = _mm_min_pd(minimum, _mm_loadu_pd(column + k));
+        double lanes[2];
+        _mm_storeu_pd(lanes, minimum);
+        for(double lane : lanes) minFlow = min(minFlow, lane);
+#endif
+        for(; k < n; k++) minFlow = min(minFlow, column[k]);
+
+        if(minFlow >= baseline[c]) continue;
+
+        for(k = 0; column[k] != minFlow; k++);
+        worst[c].loss = baseline[c] - minFlow;
+        worst[c].component = (uint32_t) k;
+    }
+    return worst;
+}
+
+bool ImpactMatrix::save(const filesystem::path &path) const {
+    ofstream file(path, ios::binary);
+    if(!file.is_open()) return false;
+
+    auto writeUint32 = [&](uint32_t value) { file.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+    auto writeString = [&](const string &value) {
+        writeUint32((uint32_t) value.size());
+        file.write(value.data(), (streamsize) value.size());
+    };
+
+    file.write("WSIM", 4);
+    writeUint32(VERSION);
+    writeUint32((uint32_t) components.size());
+    writeUint32((uint32_t) sites.size());
+    for(const string &site : sites) writeString(site);
+    for(const string &component : components) writeString(component);
+    file.write(reinterpret_cast<const char *>(baseline.data()), (streamsize) (baseline.size() * sizeof(double)));
+    file.write(reinterpret_cast<const char *>(flows.data()), (streamsize) (flows.size() * sizeof(double)));
+
+    return (bool) file;
+}
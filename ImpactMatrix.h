@@ -0,0 +1,169 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_IMPACT_MATRIX_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_IMPACT_MATRIX_H
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "FailureSweep.h"
+
+using namespace std;
+
+/**
+* @brief Worst failure of one delivery site in an impact matrix.
+*/
+struct WorstCase {
+    double loss = 0;                    // flow lost by the delivery site, 0 if no failure lowers it
+    uint32_t component = UINT32_MAX;    // index of the component whose failure loses the most, UINT32_MAX if none
+};
+
+/**
+* @brief Dense matrix with the flow of every delivery site after the failure of every component.
+*
+* @details The matrix is stored as a structure of arrays: every delivery site owns one contiguous column of doubles
+* with its flow after each failure, in the order of the components. The kernels that compare the columns with the
+* baseline flow run over those columns with SSE2 when the compiler targets it, and with plain loops otherwise, so they
+* never look up a vertex or a code. Flows keep the precision of the max flow, so the reports are written from the
+* matrix as they are.
+*
+* The binary file written by save() is, in native byte order:
+* - the magic "WSIM" and the uint32 version, number of components and number of delivery sites;
+* - the code of every delivery site and then of every component, each as a uint32 length followed by its bytes;
+* - the baseline flow of every delivery site, as doubles;
+* - the column of every delivery site, as doubles.
+*/
+class ImpactMatrix {
+private:
+    static constexpr uint32_t VERSION = 2;
+
+    vector<string> components;
+    vector<string> sites;
+    vector<double> baseline;    // flow of every delivery site without failures
+    vector<double> flows;       // column of every delivery site, one entry per component
+
+public:
+
+    /**
+     * @brief Builds the matrix of the results of a failure sweep.
+     *
+     * @param components The codes of the components, in the order of the results.
+     * @param sites The codes of the delivery sites, in the order of the flows of every result.
+     * @param baseline The flow of every delivery site without failures.
+     * @param results The result of the failure of every component.
+     *
+     * @complexity O(n * s), where n is the number of components and s is the number of delivery sites.
+     */
+    ImpactMatrix(vector<string> components, vector<string> sites, const vector<double> &baseline,
+                 const vector<FailureResult> &results);
+
+    /**
+     * @brief Get the number of components.
+     *
+     * @return The number of rows of the matrix.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] size_t getNumComponents() const;
+
+    /**
+     * @brief Get the number of delivery sites.
+     *
+     * @return The number of columns of the matrix.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] size_t getNumSites() const;
+
+    /**
+     * @brief Get the code of a component.
+     *
+     * @param component The index of the component.
+     *
+     * @return The code of the component.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] const string &getComponent(size_t component) const;
+
+    /**
+     * @brief Get the code of a delivery site.
+     *
+     * @param site The index of the delivery site.
+     *
+     * @return The code of the delivery site.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] const string &getSite(size_t site) const;
+
+    /**
+     * @brief Get the flow of a delivery site without failures.
+     *
+     * @param site The index of the delivery site.
+     *
+     * @return The baseline flow of the delivery site.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] double getBaseline(size_t site) const;
+
+    /**
+     * @brief Get the flow of a delivery site after the failure of a component.
+     *
+     * @param component The index of the component.
+     * @param site The index of the delivery site.
+     *
+     * @return The flow of the delivery site.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] double getFlow(size_t component, size_t site) const;
+
+    /**
+     * @brief Computes the flow lost by every delivery site after the failure of every component.
+     *
+     * @details The deltas have the layout of the matrix: the entry of component k and delivery site c is at
+     * c * getNumComponents() + k, and is the baseline flow minus the flow after the failure, so it is negative when the
+     * failure sends more water to the delivery site.
+     *
+     * @return The deltas, one column per delivery site.
+     *
+     * @complexity O(n * s), where n is the number of components and s is the number of delivery sites.
+     */
+    [[nodiscard]] vector<double> getDeltas() const;
+
+    /**
+     * @brief Computes the water lost by the delivery sites after the failure of every component.
+     *
+     * @return The sum of the deltas of every delivery site, one entry per component.
+     *
+     * @complexity O(n * s), where n is the number of components and s is the number of delivery sites.
+     */
+    [[nodiscard]] vector<double> getTotalLoss() const;
+
+    /**
+     * @brief Finds the failure that loses the most flow for every delivery site.
+     *
+     * @details Ties are broken by the first component.
+     *
+     * @return The worst case of every delivery site.
+     *
+     * @complexity O(n * s), where n is the number of components and s is the number of delivery sites.
+     */
+    [[nodiscard]] vector<WorstCase> getWorstCases() const;
+
+    /**
+     * @brief Writes the matrix to a binary file.
+     *
+     * @param path The path of the file.
+     *
+     * @return True if the file was written, false otherwise.
+     *
+     * @complexity O(n * s), where n is the number of components and s is the number of delivery sites.
+     */
+    bool save(const filesystem::path &path) const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_IMPACT_MATRIX_H
@@ -0,0 +1,63 @@
+#include <fstream>
+#include "MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_MMAP
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+#ifdef MAPPED_FILE_MMAP
+    if(mapped) munmap(contents, length);
+#endif
+    contents = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+bool MappedFile::open(const filesystem::path &path, bool writable) {
+    close();
+
+#ifdef MAPPED_FILE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info{};
+    if(fstat(fd, &info) == 0 && info.st_size > 0) {
+        int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *address = mmap(nullptr, (size_t) info.st_size, protection, MAP_PRIVATE, fd, 0);
+        if(address != MAP_FAILED) {
+            contents = static_cast<char *>(address);
+            length = (size_t) info.st_size;
+            mapped = true;
+            madvise(address, length, MADV_SEQUENTIAL);
+        }
+    }
+    ::close(fd);
+#endif
+
+    if(!mapped) {
+        ifstream file(path, ios::binary);
+        if(!file.is_open()) return false;
+        buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        contents = buffer.empty() ? nullptr : buffer.data();
+        length = buffer.size();
+    }
+    return true;
+}
+
+char *MappedFile::data() const {
+    return contents;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
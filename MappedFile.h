@@ -0,0 +1,71 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_MAPPED_FILE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_MAPPED_FILE_H
+
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+using namespace std;
+
+/**
+* @brief Contents of a file mapped into memory.
+*
+* @details The file is mapped privately, so writable mappings are copy-on-write and never change the file. When the
+* file cannot be mapped, it is read into a buffer instead, which behaves the same. A mapped file cannot be copied.
+*/
+class MappedFile {
+private:
+    char *contents = nullptr;   // start of the mapped or buffered file
+    size_t length = 0;          // size of the file in bytes
+    bool mapped = false;        // whether 'contents' is a mapping, or points into 'buffer'
+    vector<char> buffer;        // contents of a file that could not be mapped
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Destructor for the MappedFile class.
+     *
+     * @details Releases the mapping of the file, which invalidates every pointer into it.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Maps a file, closing the file mapped before.
+     *
+     * @param path The path of the file.
+     * @param writable Whether the contents can be written, without changing the file.
+     *
+     * @return True if the file was opened, false if it cannot be read.
+     *
+     * @complexity O(1) when the file is mapped, O(n) when it is read into a buffer, where n is the size of the file.
+     */
+    bool open(const filesystem::path &path, bool writable);
+
+    /**
+     * @brief Releases the mapping or buffer of the file.
+     *
+     * @complexity O(1).
+     */
+    void close();
+
+    /**
+     * @brief Get the contents of the file.
+     *
+     * @return Pointer to the bytes of the file, aligned to at least 8 bytes, or nullptr if the file is empty.
+     */
+    [[nodiscard]] char *data() const;
+
+    /**
+     * @brief Get the size of the file.
+     *
+     * @return The size of the file in bytes.
+     */
+    [[nodiscard]] size_t size() const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_MAPPED_FILE_H
@@ -0,0 +1,220 @@
+#include "MaxFlowSolver.h"
+#include "Algorithms.h"
+
+/********************** MaxFlowSolver  ****************************/
+
+// Function to calculate and save the incoming flow for each vertex
+static void saveIncomingFlows(Graph *g) {
+    for (Vertex *v : g->getVertexSet()) {
+        double incomingFlow = 0;
+        for (auto e: v->getIncoming()) {
+            incomingFlow += e->getFlow();
+        }
+        v->setFlow(incomingFlow);
+    }
+}
+
+void MaxFlowSolver::maxFlow(Graph *g) const {
+    ResidualGraph rg(g);
+
+    solve(rg);
+    rg.writeFlows();
+
+    // Calculate and save incoming flow for each vertex
+    saveIncomingFlows(g);
+}
+
+void MaxFlowSolver::maxFlowWithDeactivatedVertex(Graph *g, uint32_t deactivated) const {
+    ResidualGraph rg(g);
+
+    // Cancel only the flow going through the deactivated vertex, which can no longer be used
+    rg.cancelFlowThroughVertex(deactivated);
+    rg.deactivateVertex(deactivated);
+
+    solve(rg);
+    rg.writeFlows();
+
+    // Calculate and save incoming flow for each vertex
+    saveIncomingFlows(g);
+}
+
+void MaxFlowSolver::maxFlowWithDeactivatedEdge(Graph *g, uint32_t servicePointA, uint32_t servicePointB, bool unidirectional) const {
+    ResidualGraph rg(g);
+
+    // Cancel only the flow going through the deactivated pipeline, which can no longer be used
+    rg.cancelFlowThroughEdge(servicePointA, servicePointB, unidirectional);
+    rg.deactivateEdge(servicePointA, servicePointB, unidirectional);
+
+    solve(rg);
+    rg.writeFlows();
+
+    // Calculate and save incoming flow for each vertex
+    saveIncomingFlows(g);
+}
+
+DegradationCurve MaxFlowSolver::maxFlowWithDegradedEdge(Graph *g, uint32_t servicePointA, uint32_t servicePointB,
+                                                        bool unidirectional, vector<double> levels,
+                                                        const vector<uint32_t> &sites) const {
+    ResidualGraph rg(g);
+    uint32_t target = rg.getTarget();
+
+    DegradationCurve curve;
+    curve.fullFlow = rg.getIncomingFlow(target);
+
+    // The failed pipeline keeps its arcs with no capacity, so the capacity can be raised again
+    rg.cancelFlowThroughEdge(servicePointA, servicePointB, unidirectional);
+    rg.scaleEdgeCapacity(servicePointA, servicePointB, unidirectional, 0);
+    solve(rg);
+    curve.failedFlow = rg.getIncomingFlow(target);
+
+    // Raising the capacity never makes the current flow infeasible, so every level starts from the previous one
+    sort(levels.begin(), levels.end());
+    for (double level : levels) {
+        rg.scaleEdgeCapacity(servicePointA, servicePointB, unidirectional, level);
+        solve(rg);
+
+        vector<double> flows;
+        flows.reserve(sites.size());
+        for (uint32_t site : sites) flows.push_back(rg.getIncomingFlow(site));
+
+        curve.levels.push_back(level);
+        curve.maxFlows.push_back(rg.getIncomingFlow(target));
+        curve.flows.push_back(std::move(flows));
+    }
+    return curve;
+}
+
+DemandGrowth MaxFlowSolver::maxDemandGrowth(Graph *g, double tolerance) const {
+    ResidualGraph rg(g);
+    uint32_t source = rg.getSource();
+    uint32_t target = rg.getTarget();
+
+    vector<uint32_t> sites;
+    double totalDemand = 0, totalSupply = 0;
+    for (Edge *e : g->findVertex(target)->getIncoming()) {
+        sites.push_back(e->getOrig()->getId());
+        totalDemand += e->getCapacity();
+    }
+    for (Edge *e : g->findVertex(source)->getAdj()) totalSupply += e->getCapacity();
+
+    vector<double> baselineFlows;
+    rg.saveFlows(baselineFlows);
+    double baselineFlow = rg.getIncomingFlow(target);
+
+    DemandGrowth growth;
+    if (totalDemand <= 0) return growth;
+
+    // The demands cannot grow beyond the point where they use up every reservoir
+    double low = 0, high = totalSupply / totalDemand;
+    vector<double> lowFlows(baselineFlows.size(), 0);
+
+    auto tryFactor = [&](double factor) {
+        for (uint32_t site : sites) rg.scaleEdgeCapacity(site, target, true, factor);
+
+        // Any flow that was feasible for smaller demands is still feasible, so start from the one with the most water
+        if (factor <= 1 && baselineFlow * factor > totalDemand * low) {
+            vector<double> &flows = rg.getArcFlows();
+            for (size_t a = 0; a < flows.size(); a++) flows[a] = baselineFlows[a] * factor;
+        }
+        else {
+            rg.restoreFlows(lowFlows);
+        }
+
+        solve(rg);
+        growth.iterations++;
+        return rg.getIncomingFlow(target) >= totalDemand * factor * (1 - 1e-12);
+    };
+
+    if (tryFactor(high)) {
+        low = high;
+    }
+    else {
+        while (high - low > tolerance * low || low == 0) {
+            double middle = (low + high) / 2;
+            if (tryFactor(middle)) {
+                low = middle;
+                rg.saveFlows(lowFlows);
+            }
+            else {
+                high = middle;
+            }
+            if (high < tolerance) break;
+        }
+        tryFactor(high);
+    }
+
+    // The minimum cut of the last infeasible factor, or of the reservoirs if every demand can be met, limits the growth
+    vector<char> reachable;
+    rg.findSourceSide(reachable);
+    rg.findCutEdges(reachable, growth.cut);
+    growth.cut.erase(remove_if(growth.cut.begin(), growth.cut.end(),
+                               [&](const pair<uint32_t, uint32_t> &edge) { return edge.second == target; }),
+                     growth.cut.end());
+    for (uint32_t site : sites) {
+        if (!reachable[site]) growth.limitedSites.push_back(site);
+    }
+
+    growth.factor = low;
+    growth.upperBound = high;
+    return growth;
+}
+
+/********************** Solvers  ****************************/
+
+string EdmondsKarpSolver::getName() const {
+    return "edmonds-karp";
+}
+
+void EdmondsKarpSolver::solve(ResidualGraph &rg) const {
+    edmondsKarp(rg);
+}
+
+string DinicSolver::getName() const {
+    return "dinic";
+}
+
+void DinicSolver::solve(ResidualGraph &rg) const {
+    dinic(rg);
+}
+
+string PushRelabelSolver::getName() const {
+    return "push-relabel";
+}
+
+void PushRelabelSolver::solve(ResidualGraph &rg) const {
+    pushRelabel(rg);
+}
+
+/********************** MaxFlowSolverRegistry  ****************************/
+
+MaxFlowSolverRegistry::MaxFlowSolverRegistry() {
+    registerSolver(make_unique<EdmondsKarpSolver>());
+    registerSolver(make_unique<DinicSolver>());
+    registerSolver(make_unique<PushRelabelSolver>());
+}
+
+MaxFlowSolverRegistry *MaxFlowSolverRegistry::getInstance() {
+    static MaxFlowSolverRegistry instance;
+    return &instance;
+}
+
+bool MaxFlowSolverRegistry::registerSolver(unique_ptr<MaxFlowSolver> solver) {
+    if (findSolver(solver->getName()) != nullptr) return false;
+    solvers.push_back(std::move(solver));
+    return true;
+}
+
+const MaxFlowSolver *MaxFlowSolverRegistry::findSolver(const string &name) const {
+    for (const unique_ptr<MaxFlowSolver> &solver : solvers) {
+        if (solver->getName() == name) return solver.get();
+    }
+    return nullptr;
+}
+
+const MaxFlowSolver *MaxFlowSolverRegistry::getDefaultSolver() const {
+    return solvers.front().get();
+}
+
+const vector<unique_ptr<MaxFlowSolver>> &MaxFlowSolverRegistry::getSolvers() const {
+    return solvers;
+}
@@ -0,0 +1,268 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_MAX_FLOW_SOLVER_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_MAX_FLOW_SOLVER_H
+
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "Graph.h"
+#include "ResidualGraph.h"
+
+using namespace std;
+
+/**
+* @brief Abstract class representing an algorithm that computes the maximum flow of a graph.
+*
+* @details Every solver works on the residual graph of a Graph, honouring its deactivated vertices and arcs and
+* continuing from the flow already stored in it. The non-virtual functions build the residual graph, run the solver
+* and write the resulting flow back into the edges of the graph, so every solver supports the same deactivated vertex
+* and deactivated pipeline semantics.
+*/
+class MaxFlowSolver {
+public:
+
+    /**
+     * @brief Virtual destructor for the MaxFlowSolver class.
+     */
+    virtual ~MaxFlowSolver() = default;
+
+    /**
+     * @brief Get the name of the solver.
+     *
+     * @details The name identifies the solver in the registry, in the command line and in the menus.
+     *
+     * @return The name of the solver.
+     */
+    [[nodiscard]] virtual string getName() const = 0;
+
+    /**
+     * @brief Computes the maximum flow of the residual graph.
+     *
+     * @details This function sends as much flow as possible from the source to the target of the residual graph,
+     * starting from its current flow and never using deactivated vertices or arcs.
+     *
+     * @param rg Reference to the residual graph on which the solver is to be applied.
+     *
+     * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+     */
+    virtual void solve(ResidualGraph &rg) const = 0;
+
+    /**
+     * @brief Computes the maximum flow of a graph.
+     *
+     * @details This function builds the residual graph of 'g', runs the solver on it starting from the current flow
+     * of the graph, and writes the resulting flow back into the edges of the graph. Finally, it calculates and saves
+     * the incoming flow for each vertex in the graph.
+     *
+     * @param g Pointer to the graph on which the solver is to be applied.
+     *
+     * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+     *
+     * @complexity O(V + E) plus the complexity of the solver, where V is the number of vertices and E is the number
+     * of edges in the graph.
+     */
+    void maxFlow(Graph *g) const;
+
+    /**
+     * @brief Computes the maximum flow of a graph, excluding a specified deactivated vertex.
+     *
+     * @details This function builds the residual graph of 'g', cancels only the flow going through the specified
+     * vertex and deactivates it, so the solver, starting from the remaining flow of the graph, only has to re-route the
+     * flow that was lost. The resulting flow is written back into the edges of the graph. Finally, it calculates and
+     * saves the incoming flow for each vertex.
+     *
+     * @param g Pointer to the graph on which the solver is to be applied.
+     * @param deactivated The id of the vertex to be deactivated.
+     *
+     * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+     *
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the vertex, plus the complexity of the solver,
+     * where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void maxFlowWithDeactivatedVertex(Graph *g, uint32_t deactivated) const;
+
+    /**
+     * @brief Computes the maximum flow of a graph, excluding specified edges.
+     *
+     * @details This function builds the residual graph of 'g', cancels only the flow going through the edges from
+     * 'servicePointA' to 'servicePointB' (and from 'servicePointB' to 'servicePointA' if the pipeline is bidirectional)
+     * and deactivates them, so the solver, starting from the remaining flow of the graph, only has to re-route the flow
+     * that was lost. The resulting flow is written back into the edges of the graph. Finally, it calculates and saves
+     * the incoming flow for each vertex.
+     *
+     * @param g Pointer to the graph on which the solver is to be applied.
+     * @param servicePointA Id of the first service point to be excluded from edge checks.
+     * @param servicePointB Id of the second service point to be excluded from edge checks.
+     * @param unidirectional Flag indicating whether the pipeline is unidirectional or bidirectional.
+     *
+     * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+     *
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the edges, plus the complexity of the solver,
+     * where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void maxFlowWithDeactivatedEdge(Graph *g, uint32_t servicePointA, uint32_t servicePointB, bool unidirectional) const;
+
+    /**
+     * @brief Computes the maximum flow of a graph while the capacity of specified edges degrades down to zero.
+     *
+     * @details This function builds the residual graph of 'g', cancels the flow going through the edges from
+     * 'servicePointA' to 'servicePointB' (and from 'servicePointB' to 'servicePointA' if the pipeline is bidirectional)
+     * and sets their capacity to zero, like maxFlowWithDeactivatedEdge(). Then it raises their capacity through the
+     * given levels in increasing order, re-running the solver from the previous flow at each one. The flow of the graph
+     * is not changed.
+     *
+     * @param g Pointer to the graph on which the solver is to be applied.
+     * @param servicePointA Id of the first service point of the pipeline.
+     * @param servicePointB Id of the second service point of the pipeline.
+     * @param unidirectional Flag indicating whether the pipeline is unidirectional or bidirectional.
+     * @param levels The fractions of the capacity to be sampled, between 0 and 1.
+     * @param sites The vertex ids of the delivery sites whose flow is sampled.
+     *
+     * @return The max-flow curve of the pipeline, with the levels sorted.
+     *
+     * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+     *
+     * @complexity O(k * (V + E)) to cancel the k flow paths through the edges, plus L + 1 runs of the solver that
+     * only augment the flow added by each capacity increment, where L is the number of levels.
+     */
+    [[nodiscard]] DegradationCurve maxFlowWithDegradedEdge(Graph *g, uint32_t servicePointA, uint32_t servicePointB,
+                                                           bool unidirectional, vector<double> levels,
+                                                           const vector<uint32_t> &sites) const;
+
+    /**
+     * @brief Finds the largest factor by which every demand of a graph can grow while still being met.
+     *
+     * @details This function builds the residual graph of 'g' and bisects the factor that scales the capacities of the
+     * edges into the main target. A factor is feasible when every one of those edges is saturated. Each step starts
+     * from the feasible flow that carries the most water: the flow of the largest feasible factor found so far or, for
+     * factors up to 1, the current flow of the graph scaled down by the factor. The flow of the graph is not changed.
+     *
+     * @param g Pointer to the graph on which the solver is to be applied.
+     * @param tolerance The largest gap between the factor found and the exact one, relative to the exact one.
+     *
+     * @return The growth factor, its upper bound and the limiting cut.
+     *
+     * @throws std::logic_error if the source or target vertex is invalid or if the source is equal to the target.
+     *
+     * @complexity O(log(1 / tolerance)) runs of the solver, each only augmenting the flow added by the growth.
+     */
+    [[nodiscard]] DemandGrowth maxDemandGrowth(Graph *g, double tolerance) const;
+};
+
+/**
+* @brief Max-flow solver using the Edmonds-Karp algorithm.
+*/
+class EdmondsKarpSolver : public MaxFlowSolver {
+public:
+    [[nodiscard]] string getName() const override;
+
+    /**
+     * @brief Computes the maximum flow of the residual graph using the Edmonds-Karp algorithm.
+     *
+     * @complexity O(V * E^2), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void solve(ResidualGraph &rg) const override;
+};
+
+/**
+* @brief Max-flow solver using the Dinic algorithm.
+*/
+class DinicSolver : public MaxFlowSolver {
+public:
+    [[nodiscard]] string getName() const override;
+
+    /**
+     * @brief Computes the maximum flow of the residual graph using the Dinic algorithm.
+     *
+     * @complexity O(V^2 * E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void solve(ResidualGraph &rg) const override;
+};
+
+/**
+* @brief Max-flow solver using the highest-label push-relabel algorithm.
+*/
+class PushRelabelSolver : public MaxFlowSolver {
+public:
+    [[nodiscard]] string getName() const override;
+
+    /**
+     * @brief Computes the maximum flow of the residual graph using the highest-label push-relabel algorithm.
+     *
+     * @complexity O(V^2 * sqrt(E)), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void solve(ResidualGraph &rg) const override;
+};
+
+/**
+* @brief Singleton class holding every available max-flow solver, so the solver can be chosen at runtime by name.
+*/
+class MaxFlowSolverRegistry {
+private:
+    vector<unique_ptr<MaxFlowSolver>> solvers;
+
+    /**
+     * @brief Constructor for the MaxFlowSolverRegistry class.
+     *
+     * @details Registers the built-in solvers. The first one, Edmonds-Karp, is the default solver.
+     */
+    MaxFlowSolverRegistry();
+
+public:
+
+    /**
+     * @brief Gets the singleton instance of the MaxFlowSolverRegistry class.
+     *
+     * @details The instance is a function-local static, so it is created once even when several threads ask for it
+     * at the same time.
+     *
+     * @return A pointer to the singleton instance of the MaxFlowSolverRegistry class.
+     */
+    static MaxFlowSolverRegistry* getInstance();
+
+    /**
+     * @brief Registers a solver.
+     *
+     * @details The registry takes ownership of the solver, and a solver that is not registered is destroyed. Solvers
+     * cannot be replaced, since graphs keep pointers to the solver they use.
+     *
+     * @param solver The solver to be registered.
+     *
+     * @return True if the solver was registered, false if a solver with the same name already exists.
+     *
+     * @complexity O(n), where n is the number of registered solvers.
+     */
+    bool registerSolver(unique_ptr<MaxFlowSolver> solver);
+
+    /**
+     * @brief Finds a solver by its name.
+     *
+     * @param name The name of the solver.
+     *
+     * @return Pointer to the solver with the given name, or nullptr if there is no such solver.
+     *
+     * @complexity O(n), where n is the number of registered solvers.
+     */
+    [[nodiscard]] const MaxFlowSolver *findSolver(const string &name) const;
+
+    /**
+     * @brief Get the default solver.
+     *
+     * @return Pointer to the solver used when none was chosen.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] const MaxFlowSolver *getDefaultSolver() const;
+
+    /**
+     * @brief Get every registered solver, in registration order.
+     *
+     * @return Read-only view of the registered solvers.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] const vector<unique_ptr<MaxFlowSolver>> &getSolvers() const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_MAX_FLOW_SOLVER_H
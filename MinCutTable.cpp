@@ -0,0 +1,157 @@
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include "MinCutTable.h"
+
+void MinCutTable::buildIndex() {
+    sourceIndex.clear();
+    sinkIndex.clear();
+    for(size_t i = 0; i < sources.size(); i++) sourceIndex[sources[i]] = i;
+    for(size_t j = 0; j < sinks.size(); j++) sinkIndex[sinks[j]] = j;
+}
+
+ResidualGraph MinCutTable::buildPrototype() const {
+    ResidualGraph prototype(graph);
+    uint32_t source = prototype.getSource();
+    uint32_t target = prototype.getTarget();
+
+    prototype.restoreFlows(vector<double>(prototype.getNumArcs(), 0));
+    for(uint32_t id : sources) prototype.deactivateEdge(source, id, true);
+    for(uint32_t id : sinks) prototype.deactivateEdge(id, target, true);
+
+    return prototype;
+}
+
+void MinCutTable::solvePair(ResidualGraph &rg, size_t row, size_t column, vector<char> &sourceSide) {
+    uint32_t source = rg.getSource();
+    uint32_t target = rg.getTarget();
+    uint32_t reservoir = sources[row];
+    uint32_t site = sinks[column];
+
+    rg.restoreFlows(vector<double>(rg.getNumArcs(), 0));
+    rg.activateEdge(source, reservoir, true);
+    rg.activateEdge(site, target, true);
+
+    graph->getMaxFlowSolver()->solve(rg);
+
+    PairCut &cut = rows[row][column];
+    cut.maxFlow = rg.getIncomingFlow(target);
+    rg.findSourceSide(sourceSide);
+    rg.findCutEdges(sourceSide, cut.edges);
+    solved[row][column] = true;
+
+    rg.deactivateEdge(source, reservoir, true);
+    rg.deactivateEdge(site, target, true);
+}
+
+void MinCutTable::reset(Graph *g, const vector<uint32_t> &sourceIds, const vector<uint32_t> &sinkIds,
+                        unsigned int threads) {
+    graph = g;
+    numThreads = threads;
+    sources = sourceIds;
+    sinks = sinkIds;
+    buildIndex();
+    rows.assign(sources.size(), {});
+    solved.assign(sources.size(), {});
+}
+
+const PairCut *MinCutTable::find(uint32_t source, uint32_t sink) {
+    auto i = sourceIndex.find(source);
+    auto j = sinkIndex.find(sink);
+    if(i == sourceIndex.end() || j == sinkIndex.end()) return nullptr;
+
+    size_t row = i->second;
+    size_t column = j->second;
+    if(rows[row].empty()) {
+        rows[row].resize(sinks.size());
+        solved[row].assign(sinks.size(), false);
+    }
+    if(!solved[row][column]) {
+        ResidualGraph rg = buildPrototype();
+        vector<char> sourceSide;
+        solvePair(rg, row, column, sourceSide);
+    }
+
+    return &rows[row][column];
+}
+
+void MinCutTable::fill() {
+    vector<pair<size_t, size_t>> pending;
+    for(size_t row = 0; row < rows.size(); row++) {
+        if(rows[row].empty()) {
+            rows[row].resize(sinks.size());
+            solved[row].assign(sinks.size(), false);
+        }
+        for(size_t column = 0; column < sinks.size(); column++) {
+            if(!solved[row][column]) pending.emplace_back(row, column);
+        }
+    }
+    if(pending.empty()) return;
+
+    unsigned int threads = numThreads == 0 ? max(1u, thread::hardware_concurrency()) : numThreads;
+    ResidualGraph prototype = buildPrototype();
+
+    atomic<size_t> next(0);
+    exception_ptr error = nullptr;
+    mutex errorMutex;
+
+    // Every worker writes to cuts of its own, which were all allocated above
+    auto worker = [&](ResidualGraph rg) {
+        try {
+            vector<char> sourceSide;
+            for(size_t p = next++; p < pending.size(); p = next++) {
+                solvePair(rg, pending[p].first, pending[p].second, sourceSide);
+            }
+        }
+        catch(...) {
+            lock_guard<mutex> lock(errorMutex);
+            if(error == nullptr) error = current_exception();
+            next = pending.size();
+        }
+    };
+
+    size_t workers = min<size_t>(threads, pending.size());
+
+    if(workers <= 1) {
+        worker(prototype);
+    }
+    else {
+        vector<thread> pool;
+        pool.reserve(workers);
+        for(size_t i = 0; i < workers; i++) pool.emplace_back(worker, prototype);
+        for(thread &t : pool) t.join();
+    }
+
+    if(error != nullptr) rethrow_exception(error);
+}
+
+void MinCutTable::restore(Graph *g, vector<uint32_t> sourceIds, vector<uint32_t> sinkIds, vector<PairCut> pairCuts,
+                          unsigned int threads) {
+    graph = g;
+    numThreads = threads;
+    sources = std::move(sourceIds);
+    sinks = std::move(sinkIds);
+    buildIndex();
+
+    rows.assign(sources.size(), {});
+    solved.assign(sources.size(), {});
+    for(size_t row = 0; row < sources.size(); row++) {
+        auto first = pairCuts.begin() + (ptrdiff_t) (row * sinks.size());
+        rows[row].assign(make_move_iterator(first), make_move_iterator(first + (ptrdiff_t) sinks.size()));
+        solved[row].assign(sinks.size(), true);
+    }
+}
+
+const vector<uint32_t> &MinCutTable::getSources() const {
+    return sources;
+}
+
+const vector<uint32_t> &MinCutTable::getSinks() const {
+    return sinks;
+}
+
+const vector<vector<PairCut>> &MinCutTable::getRows() const {
+    return rows;
+}
@@ -0,0 +1,161 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_MIN_CUT_TABLE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_MIN_CUT_TABLE_H
+
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Graph.h"
+#include "ResidualGraph.h"
+#include "MaxFlowSolver.h"
+
+using namespace std;
+
+/**
+* @brief Minimum cut between one reservoir and one delivery site.
+*/
+struct PairCut {
+    double maxFlow = 0;                         // water the reservoir can deliver to the delivery site
+    vector<pair<uint32_t, uint32_t>> edges;     // origin and destination of every edge of the minimum cut
+};
+
+/**
+* @brief Table of the minimum cut between every reservoir and every delivery site, filled as its pairs are queried.
+*
+* @details The max flow from one reservoir to one delivery site is computed on the network with every other reservoir
+* and delivery site disconnected from the main source and target, so it is bounded by the max delivery of the reservoir,
+* the capacities of the pipelines and the demand of the delivery site. Its minimum cut is the one closest to the
+* reservoir, which is the same for every max flow, so the table does not depend on the max-flow solver.
+*
+* Loading a network only indexes its reservoirs and delivery sites. The row of a reservoir is allocated on the first
+* query for it, and every pair is solved once, on its first query, and kept. A single max flow from a reservoir to every
+* delivery site would only give each delivery site its share of one allocation, not its own max flow, so every pair
+* needs a max flow of its own. fill() solves the pairs left, split among worker threads that each have their own
+* residual graph, before the table is saved in a network snapshot.
+*
+* A Gomory-Hu tree would answer every pair with n - 1 max flows, but it only exists for undirected networks, and most
+* pipelines only carry water one way.
+*/
+class MinCutTable {
+private:
+    Graph *graph = nullptr;
+    unsigned int numThreads = 0;
+    vector<uint32_t> sources;
+    vector<uint32_t> sinks;
+    unordered_map<uint32_t, size_t> sourceIndex;
+    unordered_map<uint32_t, size_t> sinkIndex;
+    vector<vector<PairCut>> rows;   // one row per reservoir, one column per delivery site, empty until queried
+    vector<vector<char>> solved;    // whether each cut of a row was computed
+
+    /**
+     * @brief Indexes the reservoirs and delivery sites of the table.
+     *
+     * @complexity O(R + C), where R is the number of reservoirs and C is the number of delivery sites.
+     */
+    void buildIndex();
+
+    /**
+     * @brief Builds the residual graph every pair starts from: no flow, and every reservoir and delivery site
+     * disconnected from the main source and target.
+     *
+     * @return The residual graph.
+     *
+     * @complexity O(V + E + R + C), where V is the number of vertices, E is the number of edges, R is the number of
+     * reservoirs and C is the number of delivery sites.
+     */
+    [[nodiscard]] ResidualGraph buildPrototype() const;
+
+    /**
+     * @brief Computes the minimum cut of one pair on a residual graph built by buildPrototype(), and leaves the residual
+     * graph with every reservoir and delivery site disconnected again.
+     *
+     * @param rg The residual graph. Its flows are reset before the max flow.
+     * @param row The index of the reservoir.
+     * @param column The index of the delivery site.
+     * @param sourceSide Scratch buffer for the vertices reachable from the main source.
+     *
+     * @throws std::logic_error if the max-flow solver fails.
+     *
+     * @complexity O(F), where F is the complexity of the max-flow solver.
+     */
+    void solvePair(ResidualGraph &rg, size_t row, size_t column, vector<char> &sourceSide);
+
+public:
+
+    /**
+     * @brief Replaces the table with an empty one for a network, whose cuts are computed when they are needed.
+     *
+     * @param g Pointer to the graph, whose max-flow solver computes the cuts. Its flow is not changed.
+     * @param sourceIds The vertex ids of the reservoirs.
+     * @param sinkIds The vertex ids of the delivery sites.
+     * @param threads The number of worker threads of fill(), or 0 to use one per hardware thread.
+     *
+     * @complexity O(R + C), where R is the number of reservoirs and C is the number of delivery sites.
+     */
+    void reset(Graph *g, const vector<uint32_t> &sourceIds, const vector<uint32_t> &sinkIds, unsigned int threads);
+
+    /**
+     * @brief Looks up the minimum cut between a reservoir and a delivery site, computing it on its first query.
+     *
+     * @param source The vertex id of the reservoir.
+     * @param sink The vertex id of the delivery site.
+     *
+     * @return Pointer to the cut, or nullptr if the pair is not in the table.
+     *
+     * @throws std::logic_error if the max-flow solver fails.
+     *
+     * @complexity O(1) on average once the pair was computed, and O(V + E + C + F) on its first query, where V is the
+     * number of vertices, E is the number of edges, C is the number of delivery sites and F is the complexity of the
+     * max-flow solver.
+     */
+    [[nodiscard]] const PairCut *find(uint32_t source, uint32_t sink);
+
+    /**
+     * @brief Computes every cut not computed yet, so that the whole table can be saved.
+     *
+     * @throws std::logic_error if the max-flow solver fails.
+     *
+     * @complexity O(P * F / T), where P is the number of pairs not computed yet, F is the complexity of the max-flow
+     * solver and T is the number of threads.
+     */
+    void fill();
+
+    /**
+     * @brief Replaces the table with cuts computed before, such as the ones of a network snapshot.
+     *
+     * @param g Pointer to the graph of the network.
+     * @param sourceIds The vertex ids of the reservoirs.
+     * @param sinkIds The vertex ids of the delivery sites.
+     * @param pairCuts The cut of every pair, one row per reservoir and one column per delivery site.
+     * @param threads The number of worker threads of fill(), or 0 to use one per hardware thread.
+     *
+     * @complexity O(R * C), where R is the number of reservoirs and C is the number of delivery sites.
+     */
+    void restore(Graph *g, vector<uint32_t> sourceIds, vector<uint32_t> sinkIds, vector<PairCut> pairCuts,
+                 unsigned int threads);
+
+    /**
+     * @brief Get the vertex ids of the reservoirs, in the order of the rows of the table.
+     *
+     * @return The vertex ids of the reservoirs.
+     */
+    [[nodiscard]] const vector<uint32_t> &getSources() const;
+
+    /**
+     * @brief Get the vertex ids of the delivery sites, in the order of the columns of the table.
+     *
+     * @return The vertex ids of the delivery sites.
+     */
+    [[nodiscard]] const vector<uint32_t> &getSinks() const;
+
+    /**
+     * @brief Get the rows of the table, one per reservoir with one cut per delivery site. A row is empty until one of
+     * its cuts is computed, and only holds every cut after fill().
+     *
+     * @return The rows of the table.
+     */
+    [[nodiscard]] const vector<vector<PairCut>> &getRows() const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_MIN_CUT_TABLE_H
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+#include "NetworkGenerator.h"
+
+static constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+NetworkGenerator::CsvWriter::CsvWriter(const filesystem::path &path, const string &header) {
+    file.open(path, ios::binary | ios::trunc);
+    if(!file.is_open()) throw runtime_error("Error creating " + path.string() + ".");
+
+    // Same byte order mark and line breaks as the datasets
+    buffer.reserve(WRITE_BUFFER_SIZE + 256);
+    buffer += "\xEF\xBB\xBF";
+    buffer += header;
+    buffer += "\r\n";
+}
+
+NetworkGenerator::CsvWriter &NetworkGenerator::CsvWriter::field(const string &value) {
+    buffer += value;
+    buffer += ',';
+    return *this;
+}
+
+NetworkGenerator::CsvWriter &NetworkGenerator::CsvWriter::field(uint64_t value) {
+    return field(to_string(value));
+}
+
+void NetworkGenerator::CsvWriter::end(const string &value) {
+    buffer += value;
+    buffer += "\r\n";
+
+    if(buffer.size() >= WRITE_BUFFER_SIZE) {
+        file.write(buffer.data(), (streamsize) buffer.size());
+        bytes += buffer.size();
+        buffer.clear();
+    }
+}
+
+void NetworkGenerator::CsvWriter::end(uint64_t value) {
+    end(to_string(value));
+}
+
+uint64_t NetworkGenerator::CsvWriter::close() {
+    file.write(buffer.data(), (streamsize) buffer.size());
+    bytes += buffer.size();
+    buffer.clear();
+    file.close();
+    if(file.fail()) throw runtime_error("Error writing the network files.");
+    return bytes;
+}
+
+NetworkGenerator::NetworkGenerator(const GeneratorConfig &config) : config(config), rng(config.seed) {
+    if(config.reservoirs == 0 || config.stations == 0 || config.cities == 0) {
+        throw invalid_argument("The network needs at least one reservoir, one station and one city.");
+    }
+    if(config.reservoirLinks == 0 || config.cityLinks == 0) {
+        throw invalid_argument("Every reservoir and city needs at least one pipe.");
+    }
+    if(!(config.degree >= 0)) throw invalid_argument("The degree cannot be negative.");
+    if(!(config.alpha > 2)) throw invalid_argument("The power-law exponent must be above 2.");
+    if(!(config.bidirectionalRatio >= 0 && config.bidirectionalRatio <= 1)) {
+        throw invalid_argument("The bidirectional ratio must be between 0 and 1.");
+    }
+    if(config.capacity.min > config.capacity.max || config.delivery.min > config.delivery.max ||
+       config.demand.min > config.demand.max) {
+        throw invalid_argument("The minimum of a range cannot be above its maximum.");
+    }
+    if(config.shards == 0) throw invalid_argument("The number of shards must be at least 1.");
+}
+
+uint64_t NetworkGenerator::uniform(uint64_t n) {
+    if(n <= 1) return 0;
+    // Draws at or above the largest multiple of n are rejected, so every value is equally likely
+    uint64_t limit = UINT64_MAX - UINT64_MAX % n;
+    uint64_t x;
+    do x = rng(); while(x >= limit);
+    return x % n;
+}
+
+uint64_t NetworkGenerator::uniform(const ValueRange &range) {
+    if(range.max - range.min == UINT64_MAX) return rng();
+    return range.min + uniform(range.max - range.min + 1);
+}
+
+double NetworkGenerator::uniformReal() {
+    return (double) (rng() >> 11) * 0x1.0p-53;
+}
+
+string NetworkGenerator::withSeparators(uint64_t value) {
+    string digits = to_string(value);
+    string result;
+    for(size_t i = 0; i < digits.size(); i++) {
+        if(i > 0 && (digits.size() - i) % 3 == 0) result += ',';
+        result += digits[i];
+    }
+    return result;
+}
+
+GeneratorStats NetworkGenerator::generate(const filesystem::path &dir) {
+    GeneratorStats stats;
+    filesystem::create_directories(dir);
+
+    // Pipes files of an earlier network would be read together with the new ones
+    for(const auto &entry : filesystem::directory_iterator(dir)) {
+        string filename = entry.path().filename().string();
+        if(filename == "Pipes.csv" || (filename.rfind("Pipes_part", 0) == 0 && entry.path().extension() == ".csv")) {
+            filesystem::remove(entry.path());
+        }
+    }
+
+    uint64_t S = config.stations;
+
+    // The position of a station in this order is its distance from the reservoirs
+    vector<uint32_t> order(S);
+    iota(order.begin(), order.end(), 0);
+    for(uint64_t i = S - 1; i > 0; i--) swap(order[i], order[uniform(i + 1)]);
+    auto stationCode = [&](uint64_t position) { return "PS_" + to_string(order[position] + 1); };
+
+    CsvWriter reservoirs(dir / "Reservoir.csv", "Reservoir,Municipality,Id,Code,Maximum Delivery (m3/sec)");
+    uint32_t municipalities = max(1u, config.reservoirs / 3);
+    for(uint32_t i = 1; i <= config.reservoirs; i++) {
+        reservoirs.field("Reservoir " + to_string(i)).field("Municipality " + to_string(1 + (i - 1) % municipalities))
+                  .field(i).field("R_" + to_string(i)).end(uniform(config.delivery));
+    }
+    stats.bytes += reservoirs.close();
+
+    CsvWriter stations(dir / "Stations.csv", "Id,Code");
+    for(uint64_t i = 1; i <= S; i++) stations.field(i).end("PS_" + to_string(i));
+    stats.bytes += stations.close();
+
+    CsvWriter cities(dir / "Cities.csv", "City,Id,Code,Demand,Population");
+    for(uint32_t i = 1; i <= config.cities; i++) {
+        uint64_t demand = uniform(config.demand);
+        uint64_t population = demand * (100 + uniform(900));
+        cities.field("City " + to_string(i)).field(i).field("C_" + to_string(i)).field(to_string(demand) + ".00")
+              .end("\"" + withSeparators(population) + "\"");
+    }
+    stats.bytes += cities.close();
+    stats.files = 3;
+
+    // Reservoirs feed the first half of the stations, and cities are fed by the second half
+    uint64_t sourceEnd = max<uint64_t>(1, S / 2);
+    uint64_t sinkBegin = min(S / 2, S - 1);
+    uint64_t reservoirLinks = min<uint64_t>(config.reservoirLinks, sourceEnd);
+    uint64_t cityLinks = min<uint64_t>(config.cityLinks, S - sinkBegin);
+
+    uint64_t maxMeshPipes = S * (S - 1) / 2;
+    auto meshPipes = (uint64_t) llround((double) S * config.degree / 2);
+    meshPipes = min(max(meshPipes, S - 1), maxMeshPipes);
+
+    uint64_t totalPipes = config.reservoirs * reservoirLinks + meshPipes + config.cities * cityLinks;
+    uint64_t pipesPerShard = (totalPipes + config.shards - 1) / config.shards;
+
+    unique_ptr<CsvWriter> pipes;
+    auto writePipe = [&](const string &a, const string &b, uint64_t capacity, bool unidirectional) {
+        if(stats.pipes % pipesPerShard == 0) {
+            if(pipes != nullptr) stats.bytes += pipes->close();
+            string filename = config.shards == 1 ? "Pipes.csv" : "Pipes_part" + to_string(stats.files - 2) + ".csv";
+            pipes = make_unique<CsvWriter>(dir / filename, "Service_Point_A,Service_Point_B,Capacity,Direction");
+            stats.files++;
+        }
+        pipes->field(a).field(b).field(capacity).end(unidirectional ? 1 : 0);
+        stats.pipes++;
+    };
+
+    // Distinct stations for every reservoir and city, drawn again when already taken
+    vector<uint64_t> linked;
+    auto drawDistinct = [&](uint64_t begin, uint64_t end, uint64_t count) {
+        linked.clear();
+        while(linked.size() < count) {
+            uint64_t position = begin + uniform(end - begin);
+            if(find(linked.begin(), linked.end(), position) == linked.end()) linked.push_back(position);
+        }
+    };
+
+    for(uint32_t i = 1; i <= config.reservoirs; i++) {
+        drawDistinct(0, sourceEnd, reservoirLinks);
+        for(uint64_t position : linked) {
+            writePipe("R_" + to_string(i), stationCode(position), uniform(config.capacity), true);
+        }
+    }
+
+    // Station to station pipes, each pair at most once
+    unordered_set<uint64_t> used;
+    used.reserve(meshPipes);
+    uint64_t meshAdded = 0;
+    auto addMeshPipe = [&](uint64_t u, uint64_t v) {
+        if(u == v) return false;
+        if(u > v) swap(u, v);
+        if(!used.insert(u << 32 | v).second) return false;
+
+        if(uniformReal() < config.bidirectionalRatio) {
+            if(uniform(2) == 1) swap(u, v);
+            writePipe(stationCode(u), stationCode(v), uniform(config.capacity), false);
+        }
+        else {
+            writePipe(stationCode(u), stationCode(v), uniform(config.capacity), true);
+        }
+        meshAdded++;
+        return true;
+    };
+
+    // A random spanning tree keeps every station connected to the earlier ones
+    for(uint64_t v = 1; v < S; v++) addMeshPipe(uniform(v), v);
+
+    uint64_t extraPipes = meshPipes - meshAdded;
+
+    if(config.distribution == DegreeDistribution::Regular) {
+        // Configuration model: every station gets the same number of pipe ends, which are paired at random
+        vector<uint32_t> ends;
+        ends.reserve(2 * extraPipes);
+        for(uint64_t i = 0; i < 2 * extraPipes; i++) ends.push_back((uint32_t) (i % S));
+        for(uint64_t i = ends.size(); i > 1; i--) swap(ends[i - 1], ends[uniform(i)]);
+        for(uint64_t i = 0; i + 1 < ends.size(); i += 2) addMeshPipe(ends[i], ends[i + 1]);
+    }
+    else if(config.distribution == DegreeDistribution::PowerLaw) {
+        // Chung-Lu model: the ends are drawn with weights (rank + 1)^(-1 / (alpha - 1)), with the ranks spread at
+        // random over the stations, which gives degrees with a tail P(k) proportional to k^-alpha
+        vector<uint32_t> rank(S);
+        iota(rank.begin(), rank.end(), 0);
+        for(uint64_t i = S - 1; i > 0; i--) swap(rank[i], rank[uniform(i + 1)]);
+
+        vector<double> cumulative(S);
+        double total = 0;
+        for(uint64_t i = 0; i < S; i++) {
+            total += pow((double) rank[i] + 1, -1 / (config.alpha - 1));
+            cumulative[i] = total;
+        }
+        auto draw = [&]() {
+            auto it = upper_bound(cumulative.begin(), cumulative.end(), uniformReal() * total);
+            return (uint64_t) min<ptrdiff_t>(it - cumulative.begin(), (ptrdiff_t) S - 1);
+        };
+
+        for(uint64_t attempts = 0; meshAdded < meshPipes && attempts < 20 * extraPipes; attempts++) {
+            uint64_t u = draw();
+            addMeshPipe(u, draw());
+        }
+    }
+
+    // Uniform ends, and the pairs the other models could not place
+    for(uint64_t attempts = 0; meshAdded < meshPipes && attempts < 20 * extraPipes + 100; attempts++) {
+        uint64_t u = uniform(S);
+        addMeshPipe(u, uniform(S));
+    }
+
+    for(uint32_t i = 1; i <= config.cities; i++) {
+        drawDistinct(sinkBegin, S, cityLinks);
+        for(uint64_t position : linked) {
+            writePipe(stationCode(position), "C_" + to_string(i), uniform(config.capacity), true);
+        }
+    }
+
+    if(pipes != nullptr) stats.bytes += pipes->close();
+    return stats;
+}
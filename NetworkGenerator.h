@@ -0,0 +1,195 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_NETWORK_GENERATOR_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_NETWORK_GENERATOR_H
+
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+* @brief How the pipes between pumping stations are spread over the stations.
+*/
+enum class DegreeDistribution {
+    Random,     // both ends drawn uniformly, so the degrees follow a Poisson distribution
+    Regular,    // every station gets about the same number of pipes
+    PowerLaw    // a few hub stations get most of the pipes, with P(k) proportional to k^-alpha
+};
+
+/**
+* @brief Inclusive range of integer values drawn uniformly.
+*/
+struct ValueRange {
+    uint64_t min;
+    uint64_t max;
+};
+
+/**
+* @brief Parameters of a generated network.
+*
+* @details The defaults give a network of the size of the large dataset, whose supply roughly meets its demand.
+*/
+struct GeneratorConfig {
+    uint32_t reservoirs = 24;
+    uint32_t stations = 81;
+    uint32_t cities = 22;
+    double degree = 2.5;                // average number of station to station pipes per station
+    DegreeDistribution distribution = DegreeDistribution::Random;
+    double alpha = 2.5;                 // exponent of the power-law degree distribution, above 2
+    uint32_t reservoirLinks = 2;        // stations fed by each reservoir
+    uint32_t cityLinks = 2;             // stations feeding each city
+    ValueRange capacity = {50, 300};    // capacity of the pipes
+    ValueRange delivery = {100, 1500};  // maximum delivery of the reservoirs
+    ValueRange demand = {10, 150};      // demand of the cities
+    double bidirectionalRatio = 0.2;    // fraction of the station to station pipes that are bidirectional
+    uint32_t shards = 1;                // number of 'Pipes_part<k>' files, or 1 for a single 'Pipes' file
+    uint64_t seed = 1;
+};
+
+/**
+* @brief Number of rows and bytes written by NetworkGenerator::generate().
+*/
+struct GeneratorStats {
+    uint64_t pipes = 0;
+    uint64_t bytes = 0;
+    uint32_t files = 0;
+};
+
+/**
+* @brief Generator of synthetic water supply networks, written as CSV files in the schema read by Data::readFiles().
+*
+* @details The pumping stations are put in a random order, which acts as their distance from the reservoirs: the
+* reservoirs feed stations of the first half of the order, and the cities are fed by stations of the second half. A
+* random spanning tree keeps every station connected, and the remaining station to station pipes are drawn with the
+* chosen degree distribution. Unidirectional pipes always carry water from the earlier station to the later one, so the
+* water of every reservoir can reach the cities. No two pipes join the same pair of stations.
+*
+* Every value is drawn from a single 64-bit Mersenne Twister seeded with the given seed, without the distributions of
+* the standard library, whose results differ between implementations. So the same configuration always gives the same
+* files. The rows are written as they are drawn, so the pipes are never held in memory, and millions of pipes only need
+* the set of the station pairs already used.
+*/
+class NetworkGenerator {
+private:
+    /**
+     * @brief Buffered writer of the rows of a CSV file.
+     */
+    class CsvWriter {
+    private:
+        ofstream file;
+        string buffer;
+        uint64_t bytes = 0;
+
+    public:
+        /**
+         * @brief Creates a file and writes its byte order mark and header row.
+         *
+         * @throws std::runtime_error if the file cannot be created.
+         */
+        CsvWriter(const filesystem::path &path, const string &header);
+
+        /**
+         * @brief Adds a field to the current row, followed by a separator.
+         */
+        CsvWriter &field(const string &value);
+
+        /**
+         * @brief Adds an integer field to the current row, followed by a separator.
+         */
+        CsvWriter &field(uint64_t value);
+
+        /**
+         * @brief Adds the last field of the current row and ends the row.
+         */
+        void end(const string &value);
+
+        /**
+         * @brief Adds the last field of the current row, an integer, and ends the row.
+         */
+        void end(uint64_t value);
+
+        /**
+         * @brief Writes the buffered rows and closes the file.
+         *
+         * @return The size of the file in bytes.
+         *
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        uint64_t close();
+    };
+
+    GeneratorConfig config;
+    mt19937_64 rng;
+
+    /**
+     * @brief Draws an integer uniformly.
+     *
+     * @param n The number of values.
+     *
+     * @return An integer between 0 and n - 1.
+     *
+     * @complexity O(1)
+     */
+    uint64_t uniform(uint64_t n);
+
+    /**
+     * @brief Draws an integer uniformly from a range.
+     *
+     * @complexity O(1)
+     */
+    uint64_t uniform(const ValueRange &range);
+
+    /**
+     * @brief Draws a real number uniformly.
+     *
+     * @return A number between 0 and 1, excluding 1.
+     *
+     * @complexity O(1)
+     */
+    double uniformReal();
+
+    /**
+     * @brief Formats a number with thousands separators, like the populations of the datasets.
+     *
+     * @complexity O(d), where d is the number of digits.
+     */
+    static string withSeparators(uint64_t value);
+
+public:
+
+    /**
+     * @brief Builds a generator.
+     *
+     * @param config The parameters of the network.
+     *
+     * @throws std::invalid_argument if a parameter is out of range.
+     */
+    explicit NetworkGenerator(const GeneratorConfig &config);
+
+    /**
+     * @brief Writes the network to a directory, creating it if needed.
+     *
+     * @details The files are 'Reservoir.csv', 'Stations.csv', 'Cities.csv' and 'Pipes.csv', or 'Pipes_part1.csv' to
+     * 'Pipes_part<k>.csv' when the pipes are sharded. Pipes files of an earlier network in the same directory are
+     * removed, so the directory always holds one network.
+     *
+     * @param dir The directory of the network, whose name is the name of the network.
+     *
+     * @return The number of pipes, files and bytes written.
+     *
+     * @throws std::runtime_error if a file cannot be written.
+     *
+     * @complexity O(R * r^2 + S * d + C * c^2) on average, where R, S and C are the number of reservoirs, stations and
+     * cities, r and c are the number of stations linked to each reservoir and city and d is the average degree of the
+     * stations. The power-law distribution takes O(S * d * log(S)) instead of O(S * d).
+     */
+    GeneratorStats generate(const filesystem::path &dir);
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_NETWORK_GENERATOR_H
@@ -0,0 +1,197 @@
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include "NetworkSnapshot.h"
+
+// The records are read in place, so their layout is part of the format
+static_assert(sizeof(SnapshotString) == 16 && sizeof(SnapshotVertex) == 16 && sizeof(SnapshotEdge) == 32);
+static_assert(sizeof(SnapshotReservoir) == 32 && sizeof(SnapshotStation) == 16 && sizeof(SnapshotCity) == 40);
+static_assert(sizeof(SnapshotPipe) == 32 && sizeof(SnapshotPairCut) == 16 && sizeof(SnapshotCutEdge) == 8);
+
+uint32_t SnapshotContents::addString(const string &value) {
+    auto it = stringIndex.find(value);
+    if(it != stringIndex.end()) return it->second;
+
+    auto index = (uint32_t) strings.size();
+    strings.push_back({characters.size(), value.size()});
+    characters += value;
+    stringIndex.emplace(value, index);
+    return index;
+}
+
+bool NetworkSnapshot::save(const filesystem::path &path, SnapshotContents &contents) {
+    SnapshotHeader &h = contents.header;
+    memcpy(h.magic, "WSNT", 4);
+    h.version = VERSION;
+    h.byteOrder = ENDIANNESS;
+
+    // Every section starts at a multiple of 8 bytes, so its records can be read in place from the mapping
+    vector<pair<const void *, size_t>> chunks;
+    uint64_t offset = sizeof(SnapshotHeader);
+    auto place = [&](SnapshotSection &section, const void *data, size_t count, size_t recordSize) {
+        offset = (offset + 7) & ~(uint64_t) 7;
+        section.offset = offset;
+        section.count = count;
+        chunks.emplace_back(data, count * recordSize);
+        offset += count * recordSize;
+    };
+
+    place(h.strings, contents.strings.data(), contents.strings.size(), sizeof(SnapshotString));
+    place(h.characters, contents.characters.data(), contents.characters.size(), 1);
+    place(h.vertices, contents.vertices.data(), contents.vertices.size(), sizeof(SnapshotVertex));
+    place(h.edges, contents.edges.data(), contents.edges.size(), sizeof(SnapshotEdge));
+    place(h.reservoirs, contents.reservoirs.data(), contents.reservoirs.size(), sizeof(SnapshotReservoir));
+    place(h.stations, contents.stations.data(), contents.stations.size(), sizeof(SnapshotStation));
+    place(h.cities, contents.cities.data(), contents.cities.size(), sizeof(SnapshotCity));
+    place(h.pipes, contents.pipes.data(), contents.pipes.size(), sizeof(SnapshotPipe));
+    place(h.cutSources, contents.cutSources.data(), contents.cutSources.size(), sizeof(uint32_t));
+    place(h.cutSinks, contents.cutSinks.data(), contents.cutSinks.size(), sizeof(uint32_t));
+    place(h.cuts, contents.cuts.data(), contents.cuts.size(), sizeof(SnapshotPairCut));
+    place(h.cutEdges, contents.cutEdges.data(), contents.cutEdges.size(), sizeof(SnapshotCutEdge));
+
+    error_code error;
+    filesystem::create_directories(path.parent_path(), error);
+
+    filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        ofstream file(tempPath, ios::binary);
+        if(!file.is_open()) return false;
+
+        const char zeros[8] = {};
+        file.write(reinterpret_cast<const char *>(&h), sizeof(h));
+        uint64_t written = sizeof(h);
+        for(const auto &chunk : chunks) {
+            uint64_t padding = ((written + 7) & ~(uint64_t) 7) - written;
+            file.write(zeros, (streamsize) padding);
+            file.write(static_cast<const char *>(chunk.first), (streamsize) chunk.second);
+            written += padding + chunk.second;
+        }
+        if(!file) return false;
+    }
+
+    filesystem::rename(tempPath, path, error);
+    return !error;
+}
+
+bool NetworkSnapshot::validSection(const SnapshotSection &section, size_t recordSize) const {
+    if(section.offset % 8 != 0 || section.offset > file.size()) return false;
+    return section.count <= (file.size() - section.offset) / recordSize;
+}
+
+bool NetworkSnapshot::validIndices() const {
+    const SnapshotHeader &h = *header;
+    uint64_t numStrings = h.strings.count;
+    uint64_t numVertices = h.vertices.count;
+
+    const auto *strings = getRecords<SnapshotString>(h.strings);
+    for(uint64_t i = 0; i < numStrings; i++) {
+        if(strings[i].offset > h.characters.count || strings[i].length > h.characters.count - strings[i].offset) {
+            return false;
+        }
+    }
+    if(h.networkName >= numStrings || h.solverName >= numStrings) return false;
+    if(h.mainSource >= numVertices || h.mainTarget >= numVertices) return false;
+
+    const auto *vertices = getRecords<SnapshotVertex>(h.vertices);
+    for(uint64_t i = 0; i < numVertices; i++) {
+        if(vertices[i].code >= numStrings || vertices[i].type > 4) return false;
+    }
+
+    const auto *edges = getRecords<SnapshotEdge>(h.edges);
+    for(uint64_t i = 0; i < h.edges.count; i++) {
+        if(edges[i].orig >= numVertices || edges[i].dest >= numVertices) return false;
+        if(edges[i].reverse != NO_EDGE && edges[i].reverse >= h.edges.count) return false;
+    }
+
+    const auto *reservoirs = getRecords<SnapshotReservoir>(h.reservoirs);
+    for(uint64_t i = 0; i < h.reservoirs.count; i++) {
+        const SnapshotReservoir &r = reservoirs[i];
+        if(r.name >= numStrings || r.municipality >= numStrings || r.code >= numStrings) return false;
+        if(r.vertex >= numVertices) return false;
+    }
+
+    const auto *stations = getRecords<SnapshotStation>(h.stations);
+    for(uint64_t i = 0; i < h.stations.count; i++) {
+        if(stations[i].code >= numStrings || stations[i].vertex >= numVertices) return false;
+    }
+
+    const auto *cities = getRecords<SnapshotCity>(h.cities);
+    for(uint64_t i = 0; i < h.cities.count; i++) {
+        const SnapshotCity &c = cities[i];
+        if(c.city >= numStrings || c.code >= numStrings || c.vertex >= numVertices) return false;
+    }
+
+    const auto *pipes = getRecords<SnapshotPipe>(h.pipes);
+    for(uint64_t i = 0; i < h.pipes.count; i++) {
+        const SnapshotPipe &p = pipes[i];
+        if(p.key >= numStrings || p.servicePointA >= numStrings || p.servicePointB >= numStrings) return false;
+        // A service point missing from the network has no vertex, which the graph marks with the largest id
+        bool validA = p.vertexA < numVertices || p.vertexA == numeric_limits<uint32_t>::max();
+        bool validB = p.vertexB < numVertices || p.vertexB == numeric_limits<uint32_t>::max();
+        if(!validA || !validB) return false;
+    }
+
+    const auto *cutSources = getRecords<uint32_t>(h.cutSources);
+    for(uint64_t i = 0; i < h.cutSources.count; i++) {
+        if(cutSources[i] >= numVertices) return false;
+    }
+    const auto *cutSinks = getRecords<uint32_t>(h.cutSinks);
+    for(uint64_t i = 0; i < h.cutSinks.count; i++) {
+        if(cutSinks[i] >= numVertices) return false;
+    }
+
+    if(h.cuts.count != h.cutSources.count * h.cutSinks.count) return false;
+    const auto *cuts = getRecords<SnapshotPairCut>(h.cuts);
+    for(uint64_t i = 0; i < h.cuts.count; i++) {
+        if(cuts[i].firstEdge > h.cutEdges.count || cuts[i].numEdges > h.cutEdges.count - cuts[i].firstEdge) {
+            return false;
+        }
+    }
+    const auto *cutEdges = getRecords<SnapshotCutEdge>(h.cutEdges);
+    for(uint64_t i = 0; i < h.cutEdges.count; i++) {
+        if(cutEdges[i].orig >= numVertices || cutEdges[i].dest >= numVertices) return false;
+    }
+    return true;
+}
+
+void NetworkSnapshot::open(const filesystem::path &path) {
+    header = nullptr;
+    if(!file.open(path, false)) throw runtime_error("Error opening the network snapshot.");
+
+    if(file.size() < sizeof(SnapshotHeader) || memcmp(file.data(), "WSNT", 4) != 0) {
+        throw runtime_error("Invalid network snapshot: " + path.filename().string() + " is not a snapshot.");
+    }
+
+    const auto *h = reinterpret_cast<const SnapshotHeader *>(file.data());
+    if(h->byteOrder != ENDIANNESS) {
+        throw runtime_error("Invalid network snapshot: it was written with another byte order.");
+    }
+    if(h->version != VERSION) {
+        throw runtime_error("Invalid network snapshot: version " + to_string(h->version) + " is not supported.");
+    }
+    header = h;
+
+    bool valid = validSection(h->strings, sizeof(SnapshotString)) && validSection(h->characters, 1) &&
+                 validSection(h->vertices, sizeof(SnapshotVertex)) && validSection(h->edges, sizeof(SnapshotEdge)) &&
+                 validSection(h->reservoirs, sizeof(SnapshotReservoir)) &&
+                 validSection(h->stations, sizeof(SnapshotStation)) && validSection(h->cities, sizeof(SnapshotCity)) &&
+                 validSection(h->pipes, sizeof(SnapshotPipe)) && validSection(h->cutSources, sizeof(uint32_t)) &&
+                 validSection(h->cutSinks, sizeof(uint32_t)) && validSection(h->cuts, sizeof(SnapshotPairCut)) &&
+                 validSection(h->cutEdges, sizeof(SnapshotCutEdge)) && validIndices();
+    if(!valid) {
+        header = nullptr;
+        throw runtime_error("Invalid network snapshot: the file is truncated or corrupted.");
+    }
+}
+
+const SnapshotHeader &NetworkSnapshot::getHeader() const {
+    return *header;
+}
+
+string_view NetworkSnapshot::getString(uint32_t index) const {
+    const SnapshotString &s = getRecords<SnapshotString>(header->strings)[index];
+    return {file.data() + header->characters.offset + s.offset, (size_t) s.length};
+}
@@ -0,0 +1,257 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_NETWORK_SNAPSHOT_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_NETWORK_SNAPSHOT_H
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "MappedFile.h"
+
+using namespace std;
+
+/**
+* @brief Position of an array of records in a network snapshot.
+*/
+struct SnapshotSection {
+    uint64_t offset = 0;    // offset of the first record from the start of the file, a multiple of 8
+    uint64_t count = 0;     // number of records
+};
+
+/**
+* @brief Offset and length of a string in the character section of a network snapshot.
+*/
+struct SnapshotString {
+    uint64_t offset;
+    uint64_t length;
+};
+
+/**
+* @brief Vertex of the graph, in vertex id order.
+*/
+struct SnapshotVertex {
+    uint32_t code;          // string index
+    uint32_t type;          // VertexType
+    double flow;
+};
+
+/**
+* @brief Edge of the graph, in creation order.
+*/
+struct SnapshotEdge {
+    uint32_t orig;
+    uint32_t dest;
+    uint32_t reverse;       // position of the reverse edge, or NO_EDGE
+    uint32_t padding;
+    double capacity;
+    double flow;
+};
+
+struct SnapshotReservoir {
+    uint32_t name;          // string index
+    uint32_t municipality;  // string index
+    uint32_t code;          // string index
+    uint32_t vertex;
+    double id;
+    double maxDelivery;
+};
+
+struct SnapshotStation {
+    uint32_t code;          // string index
+    uint32_t vertex;
+    double id;
+};
+
+struct SnapshotCity {
+    uint32_t city;          // string index
+    uint32_t code;          // string index
+    uint32_t vertex;
+    uint32_t padding;
+    double id;
+    double demand;
+    double population;
+};
+
+struct SnapshotPipe {
+    uint32_t key;           // string index of the code, empty unless a service point is missing from the network
+    uint32_t servicePointA; // string index
+    uint32_t servicePointB; // string index
+    uint32_t vertexA;
+    uint32_t vertexB;
+    uint32_t unidirectional;
+    double capacity;
+};
+
+/**
+* @brief Minimum cut of one reservoir and delivery site pair, whose edges are a range of the cut edge section.
+*/
+struct SnapshotPairCut {
+    double maxFlow;
+    uint32_t firstEdge;
+    uint32_t numEdges;
+};
+
+struct SnapshotCutEdge {
+    uint32_t orig;
+    uint32_t dest;
+};
+
+/**
+* @brief Fixed-size header at the start of a network snapshot.
+*/
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;                 // ENDIANNESS as written, so a snapshot of another byte order is rejected
+    uint32_t networkName;               // string index
+    uint64_t inputsFingerprint;         // hash of the input files the snapshot was built from
+    uint32_t solverName;                // string index of the solver of the baseline max flow
+    uint32_t mainSource;
+    uint32_t mainTarget;
+    uint32_t padding;
+    double metrics[10];                 // GraphMetrics, in the order of its constructor
+    SnapshotSection strings;
+    SnapshotSection characters;
+    SnapshotSection vertices;
+    SnapshotSection edges;
+    SnapshotSection reservoirs;
+    SnapshotSection stations;
+    SnapshotSection cities;
+    SnapshotSection pipes;
+    SnapshotSection cutSources;         // uint32_t vertex ids, one per row of the min-cut table
+    SnapshotSection cutSinks;           // uint32_t vertex ids, one per column of the min-cut table
+    SnapshotSection cuts;
+    SnapshotSection cutEdges;
+};
+
+/**
+* @brief Contents of a network snapshot to be written, with its strings interned as they are added.
+*/
+struct SnapshotContents {
+    SnapshotHeader header{};
+    vector<SnapshotString> strings;
+    string characters;
+    vector<SnapshotVertex> vertices;
+    vector<SnapshotEdge> edges;
+    vector<SnapshotReservoir> reservoirs;
+    vector<SnapshotStation> stations;
+    vector<SnapshotCity> cities;
+    vector<SnapshotPipe> pipes;
+    vector<uint32_t> cutSources;
+    vector<uint32_t> cutSinks;
+    vector<SnapshotPairCut> cuts;
+    vector<SnapshotCutEdge> cutEdges;
+    unordered_map<string, uint32_t> stringIndex;
+
+    /**
+     * @brief Interns a string.
+     *
+     * @param value The string.
+     *
+     * @return The index of the string, shared by every equal string.
+     *
+     * @complexity O(l) on average, where l is the length of the string.
+     */
+    uint32_t addString(const string &value);
+};
+
+/**
+* @brief Binary snapshot of a loaded network (.wsnet), which is loaded again without parsing or solving.
+*
+* @details A snapshot holds the interned codes and names, the entity tables in the order the reports visit the
+* entities, the topology of the graph with its edges in creation order, the baseline max flow of every edge and vertex,
+* the metrics and the reservoir to delivery site min-cut table. Every section is an array of fixed-size records aligned to 8 bytes, so once the file is mapped the
+* records are read in place. The header holds a magic number, a format version and the byte order, and every section
+* and index is checked against the size of the file before it is used.
+*/
+class NetworkSnapshot {
+private:
+    MappedFile file;
+    const SnapshotHeader *header = nullptr;
+
+    /**
+     * @brief Checks that a section lies inside the file.
+     *
+     * @param section The section.
+     * @param recordSize The size of its records.
+     *
+     * @return True if the section is valid.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] bool validSection(const SnapshotSection &section, size_t recordSize) const;
+
+    /**
+     * @brief Checks every index of the snapshot against the sections it points into.
+     *
+     * @return True if every index is valid.
+     *
+     * @complexity O(n), where n is the number of records of the snapshot.
+     */
+    [[nodiscard]] bool validIndices() const;
+
+public:
+    static constexpr const char *EXTENSION = ".wsnet";
+    static constexpr uint32_t VERSION = 3;
+    static constexpr uint32_t ENDIANNESS = 0x01020304;
+    static constexpr uint32_t NO_EDGE = UINT32_MAX;
+
+    /**
+     * @brief Writes a snapshot file, replacing it only once it is complete.
+     *
+     * @param path The path of the snapshot.
+     * @param contents The contents of the snapshot. The magic number, version, byte order and sections of its header
+     * are filled in.
+     *
+     * @return True if the snapshot was written.
+     *
+     * @complexity O(n), where n is the size of the snapshot.
+     */
+    static bool save(const filesystem::path &path, SnapshotContents &contents);
+
+    /**
+     * @brief Maps a snapshot file and checks it.
+     *
+     * @param path The path of the snapshot.
+     *
+     * @throws std::runtime_error if the file cannot be read, is not a snapshot, has another version or byte order, or
+     * is truncated or corrupted.
+     *
+     * @complexity O(n), where n is the number of records, to check the indices.
+     */
+    void open(const filesystem::path &path);
+
+    /**
+     * @brief Get the header of the snapshot.
+     *
+     * @return The header.
+     */
+    [[nodiscard]] const SnapshotHeader &getHeader() const;
+
+    /**
+     * @brief Get a string of the snapshot.
+     *
+     * @param index The index of the string.
+     *
+     * @return View of the string, valid while the snapshot is open.
+     */
+    [[nodiscard]] string_view getString(uint32_t index) const;
+
+    /**
+     * @brief Get the records of a section.
+     *
+     * @tparam T The type of the records.
+     * @param section The section.
+     *
+     * @return Pointer to the first record, valid while the snapshot is open.
+     */
+    template <class T>
+    [[nodiscard]] const T *getRecords(const SnapshotSection &section) const {
+        return reinterpret_cast<const T *>(file.data() + section.offset);
+    }
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_NETWORK_SNAPSHOT_H
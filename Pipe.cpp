@@ -1,7 +1,7 @@
 #include "Pipe.h"
 
-Pipe::Pipe(string servicePointA, string servicePointB, double capacity, bool unidirectional)
-    : servicePointA(std::move(servicePointA)), servicePointB(std::move(servicePointB)), capacity(capacity), unidirectional(unidirectional) {}
+Pipe::Pipe(string servicePointA, string servicePointB, uint32_t vertexA, uint32_t vertexB, double capacity, bool unidirectional)
+    : servicePointA(std::move(servicePointA)), servicePointB(std::move(servicePointB)), vertexA(vertexA), vertexB(vertexB), capacity(capacity), unidirectional(unidirectional) {}
 
 string Pipe::getServicePointA() {
     return this->servicePointA;
@@ -11,6 +11,14 @@ string Pipe::getServicePointB() {
     return this->servicePointB;
 }
 
+uint32_t Pipe::getVertexA() const {
+    return this->vertexA;
+}
+
+uint32_t Pipe::getVertexB() const {
+    return this->vertexB;
+}
+
 bool Pipe::getUnidirectional() const {
     return this->unidirectional;
 }
@@ -18,3 +26,7 @@ bool Pipe::getUnidirectional() const {
 double Pipe::getCapacity() const {
     return this->capacity;
 }
+
+double Pipe::getDegradedCapacity(double level) const {
+    return this->capacity * level;
+}
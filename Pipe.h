@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <cstdint>
 #include <utility>
 using namespace std;
 
@@ -14,6 +15,8 @@ class Pipe {
 private :
     string servicePointA;
     string servicePointB;
+    uint32_t vertexA;
+    uint32_t vertexB;
     double capacity;
     bool unidirectional;
 
@@ -27,10 +30,12 @@ public:
     *
     * @param servicePointA The source service that can be a water reservoir, a pumping station, or delivery site.
     * @param servicePointB The target service that can be a water reservoir, pumping station, or a delivery site.
+    * @param vertexA The id of the vertex representing service point A in the network graph.
+    * @param vertexB The id of the vertex representing service point B in the network graph.
     * @param capacity The maximum capacity of the pipe.
     * @param unidirectional Boolean indicating whether the connection between source service and target service is undirected or bi-directed
     */
-    Pipe(string servicePointA, string servicePointB, double capacity, bool unidirectional);
+    Pipe(string servicePointA, string servicePointB, uint32_t vertexA, uint32_t vertexB, double capacity, bool unidirectional);
 
     /**
      * @brief Get the name of service point A.
@@ -46,6 +51,20 @@ public:
      */
     string getServicePointB();
 
+    /**
+     * @brief Get the id of the vertex representing service point A.
+     *
+     * @return The vertex id of service point A.
+     */
+    [[nodiscard]] uint32_t getVertexA() const;
+
+    /**
+     * @brief Get the id of the vertex representing service point B.
+     *
+     * @return The vertex id of service point B.
+     */
+    [[nodiscard]] uint32_t getVertexB() const;
+
     /**
      * @brief Check if the pipe is unidirectional.
      *
@@ -59,6 +78,15 @@ public:
      * @return The capacity of the pipe.
      */
     [[nodiscard]] double getCapacity() const;
+
+    /**
+     * @brief Get the capacity of the pipe when it keeps only a fraction of its capacity, such as a silted or throttled pipe.
+     *
+     * @param level The fraction of the capacity left, between 0 (out of commission) and 1 (full capacity).
+     *
+     * @return The degraded capacity of the pipe.
+     */
+    [[nodiscard]] double getDegradedCapacity(double level) const;
 };
 
 
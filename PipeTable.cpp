@@ -0,0 +1,106 @@
+#include <algorithm>
+#include "PipeTable.h"
+
+// Mixes the pair of vertex ids, so consecutive ids do not fall in consecutive slots
+static uint64_t hashPair(uint32_t vertexA, uint32_t vertexB) {
+    uint64_t x = ((uint64_t) vertexA << 32) | vertexB;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+PipeTable::PipeTable(const Graph *graph) : graph(graph) {}
+
+size_t PipeTable::findSlot(uint32_t vertexA, uint32_t vertexB) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hashPair(vertexA, vertexB) & mask;
+    while(slots[slot] != NO_SLOT) {
+        const EdgeSpec &pipe = pipes[slots[slot]];
+        if(pipe.source == vertexA && pipe.dest == vertexB) break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void PipeTable::grow() {
+    vector<uint32_t> old(max<size_t>(16, slots.size() * 2), NO_SLOT);
+    old.swap(slots);
+    for(uint32_t pipe : old) {
+        if(pipe != NO_SLOT) slots[findSlot(pipes[pipe].source, pipes[pipe].dest)] = pipe;
+    }
+}
+
+void PipeTable::reserve(size_t numPipes) {
+    pipes.reserve(pipes.size() + numPipes);
+    // The index is kept at most half full
+    while(slots.size() < 2 * (numIndexed + numPipes)) grow();
+}
+
+uint32_t PipeTable::add(uint32_t vertexA, uint32_t vertexB, double capacity, bool unidirectional) {
+    auto index = (uint32_t) pipes.size();
+    pipes.push_back({vertexA, vertexB, capacity, !unidirectional});
+
+    if(2 * (numIndexed + 1) > slots.size()) grow();
+    size_t slot = findSlot(vertexA, vertexB);
+    if(slots[slot] == NO_SLOT) {
+        slots[slot] = index;
+        numIndexed++;
+    }
+    return index;
+}
+
+uint32_t PipeTable::add(string servicePointA, string servicePointB, uint32_t vertexA, uint32_t vertexB,
+                        double capacity, bool unidirectional) {
+    auto index = (uint32_t) pipes.size();
+    pipes.push_back({vertexA, vertexB, capacity, !unidirectional});
+
+    unknownIndex.insert({servicePointA + "-" + servicePointB, index});
+    unknownCodes.insert({index, {std::move(servicePointA), std::move(servicePointB)}});
+    return index;
+}
+
+size_t PipeTable::size() const {
+    return pipes.size();
+}
+
+bool PipeTable::isListed(uint32_t pipe) const {
+    auto it = unknownCodes.find(pipe);
+    if(it != unknownCodes.end()) return unknownIndex.at(it->second.first + "-" + it->second.second) == pipe;
+    return slots[findSlot(pipes[pipe].source, pipes[pipe].dest)] == pipe;
+}
+
+uint32_t PipeTable::find(const string &code) const {
+    if(!slots.empty()) {
+        for(size_t dashPos = code.find('-'); dashPos != string::npos; dashPos = code.find('-', dashPos + 1)) {
+            uint32_t vertexA = graph->findVertexId(code.substr(0, dashPos));
+            uint32_t vertexB = graph->findVertexId(code.substr(dashPos + 1));
+            if(vertexA == NO_VERTEX || vertexB == NO_VERTEX) continue;
+
+            size_t slot = findSlot(vertexA, vertexB);
+            if(slots[slot] != NO_SLOT) return slots[slot];
+        }
+    }
+
+    auto it = unknownIndex.find(code);
+    return it != unknownIndex.end() ? it->second : NO_PIPE;
+}
+
+string PipeTable::getCode(uint32_t pipe) const {
+    auto it = unknownCodes.find(pipe);
+    if(it != unknownCodes.end()) return it->second.first + "-" + it->second.second;
+    return graph->findVertex(pipes[pipe].source)->getCode() + "-" + graph->findVertex(pipes[pipe].dest)->getCode();
+}
+
+Pipe PipeTable::get(uint32_t pipe) const {
+    const EdgeSpec &p = pipes[pipe];
+    auto it = unknownCodes.find(pipe);
+    if(it != unknownCodes.end()) {
+        return {it->second.first, it->second.second, p.source, p.dest, p.capacity, !p.bidirectional};
+    }
+    return {graph->findVertex(p.source)->getCode(), graph->findVertex(p.dest)->getCode(), p.source, p.dest, p.capacity,
+            !p.bidirectional};
+}
+
+const vector<EdgeSpec> &PipeTable::getEdges() const {
+    return pipes;
+}
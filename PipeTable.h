@@ -0,0 +1,174 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_PIPE_TABLE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_PIPE_TABLE_H
+
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Graph.h"
+#include "Pipe.h"
+
+using namespace std;
+
+/**
+* @brief Packed table of the pipes of a network, in the order they were read.
+*
+* @details Every pipe is one fixed-size record holding the vertex ids of its service points, its capacity and its
+* direction, which is also the record Graph::addEdges() builds the graph from. The codes of the service points are not
+* stored, they are the codes of the vertices. So a pipe costs a record and a slot of the index, instead of a heap object
+* with two strings and a map node keyed by another string.
+*
+* A pipe is known by the code "A-B" of its service points. When several rows join the same service points in the same
+* order, every row is kept, since each one adds its own edge to the graph, but the code only names the first one: that
+* is the listed pipe. The codes are indexed in an open-addressing hash table from the pair of vertex ids. Pipes with a
+* service point missing from the network keep their codes in a side map, since they have no vertex.
+*/
+class PipeTable {
+private:
+    static constexpr uint32_t NO_SLOT = numeric_limits<uint32_t>::max();
+
+    const Graph *graph;
+    vector<EdgeSpec> pipes;                                 // one record per row, in file order
+    vector<uint32_t> slots;                                 // index of the listed pipes, by service points
+    size_t numIndexed = 0;
+    unordered_map<uint32_t, pair<string, string>> unknownCodes; // codes of the pipes with a missing service point
+    unordered_map<string, uint32_t> unknownIndex;           // listed pipe of each of those codes
+
+    /**
+     * @brief Finds the slot of a pair of service points in the index.
+     *
+     * @param vertexA The vertex id of the first service point.
+     * @param vertexB The vertex id of the second service point.
+     *
+     * @return The slot holding the pipe between them, or the empty slot where it would be inserted.
+     *
+     * @complexity O(1) on average.
+     */
+    [[nodiscard]] size_t findSlot(uint32_t vertexA, uint32_t vertexB) const;
+
+    /**
+     * @brief Doubles the size of the index and inserts the listed pipes again.
+     *
+     * @complexity O(n), where n is the number of pipes.
+     */
+    void grow();
+
+public:
+    static constexpr uint32_t NO_PIPE = numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Builds an empty table.
+     *
+     * @param graph Pointer to the graph whose vertices are the service points of the pipes.
+     */
+    explicit PipeTable(const Graph *graph);
+
+    /**
+     * @brief Reserves room for more pipes.
+     *
+     * @param numPipes The number of pipes about to be added.
+     *
+     * @complexity O(n), where n is the number of pipes in the table.
+     */
+    void reserve(size_t numPipes);
+
+    /**
+     * @brief Adds a pipe between two service points of the network.
+     *
+     * @param vertexA The vertex id of the first service point.
+     * @param vertexB The vertex id of the second service point.
+     * @param capacity The capacity of the pipe.
+     * @param unidirectional True if the water only flows from the first service point to the second.
+     *
+     * @return The index of the new pipe.
+     *
+     * @complexity O(1) amortized.
+     */
+    uint32_t add(uint32_t vertexA, uint32_t vertexB, double capacity, bool unidirectional);
+
+    /**
+     * @brief Adds a pipe with at least one service point missing from the network.
+     *
+     * @details The pipe is kept so it can be looked up by its code, but it has no edge in the graph.
+     *
+     * @param servicePointA The code of the first service point.
+     * @param servicePointB The code of the second service point.
+     * @param vertexA The vertex id of the first service point, or NO_VERTEX.
+     * @param vertexB The vertex id of the second service point, or NO_VERTEX.
+     * @param capacity The capacity of the pipe.
+     * @param unidirectional True if the water only flows from the first service point to the second.
+     *
+     * @return The index of the new pipe.
+     *
+     * @complexity O(1) amortized.
+     */
+    uint32_t add(string servicePointA, string servicePointB, uint32_t vertexA, uint32_t vertexB, double capacity,
+                 bool unidirectional);
+
+    /**
+     * @brief Retrieves the number of pipes, including the ones that are not listed.
+     *
+     * @complexity O(1)
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Checks if a pipe is the one named by its code, which is the first row between its service points.
+     *
+     * @param pipe The index of the pipe.
+     *
+     * @return True if the pipe is listed.
+     *
+     * @complexity O(1) on average.
+     */
+    [[nodiscard]] bool isListed(uint32_t pipe) const;
+
+    /**
+     * @brief Looks up a pipe by its code.
+     *
+     * @details Service point codes may hold a '-' themselves, so every split of the code is tried.
+     *
+     * @param code The code "A-B" of the pipe.
+     *
+     * @return The index of the listed pipe with that code, or NO_PIPE.
+     *
+     * @complexity O(l * d) on average, where l is the length of the code and d is the number of '-' in it.
+     */
+    [[nodiscard]] uint32_t find(const string &code) const;
+
+    /**
+     * @brief Retrieves the code "A-B" of a pipe.
+     *
+     * @param pipe The index of the pipe.
+     *
+     * @complexity O(l), where l is the length of the code.
+     */
+    [[nodiscard]] string getCode(uint32_t pipe) const;
+
+    /**
+     * @brief Retrieves a pipe.
+     *
+     * @param pipe The index of the pipe.
+     *
+     * @return A copy of the pipe, with the codes of its service points.
+     *
+     * @complexity O(l), where l is the length of the codes.
+     */
+    [[nodiscard]] Pipe get(uint32_t pipe) const;
+
+    /**
+     * @brief Retrieves the record of every pipe, in file order.
+     *
+     * @details Pipes with a missing service point have NO_VERTEX as source or destination, and Graph::addEdges()
+     * skips them.
+     *
+     * @complexity O(1)
+     */
+    [[nodiscard]] const vector<EdgeSpec> &getEdges() const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_PIPE_TABLE_H
@@ -1,3 +1,11 @@
 #include "PumpingStation.h"
 
-PumpingStation::PumpingStation(double id, string code) : id(id), code(std::move(code)) {}
+PumpingStation::PumpingStation(double id, string code, uint32_t vertexId) : id(id), code(std::move(code)), vertexId(vertexId) {}
+
+double PumpingStation::getId() const {
+    return this->id;
+}
+
+uint32_t PumpingStation::getVertexId() const {
+    return this->vertexId;
+}
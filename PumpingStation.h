@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <cstdint>
 #include <utility>
 using namespace std;
 
@@ -14,6 +15,7 @@ class PumpingStation {
 private :
     double id;
     string code;
+    uint32_t vertexId;
 
 public:
 
@@ -25,8 +27,23 @@ public:
     *
     * @param id The id of the pumping station.
     * @param code The unique code assigned to the pumping station.
+    * @param vertexId The id of the vertex representing the pumping station in the network graph.
     */
-    PumpingStation(double id, string code);
+    PumpingStation(double id, string code, uint32_t vertexId);
+
+    /**
+     * @brief Get the id of the pumping station.
+     *
+     * @return The id of the pumping station.
+     */
+    [[nodiscard]] double getId() const;
+
+    /**
+     * @brief Get the id of the vertex representing the pumping station in the network graph.
+     *
+     * @return The vertex id of the pumping station.
+     */
+    [[nodiscard]] uint32_t getVertexId() const;
 };
 
 
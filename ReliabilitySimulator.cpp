@@ -0,0 +1,187 @@
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include "ReliabilitySimulator.h"
+
+ReliabilitySimulator::ReliabilitySimulator(Graph *g, vector<FailureCase> components, vector<double> probabilities,
+                                           vector<uint32_t> sites, vector<double> demands, unsigned int numThreads)
+        : prototype(g), solver(g->getMaxFlowSolver()), components(std::move(components)),
+          probabilities(std::move(probabilities)), sites(std::move(sites)), demands(std::move(demands)),
+          numThreads(numThreads) {
+    if(this->numThreads == 0) this->numThreads = max(1u, thread::hardware_concurrency());
+}
+
+uint32_t ReliabilitySimulator::getBin(size_t site, double unmet, const vector<double> &binWidth) const {
+    if(unmet <= 0) return 0;
+    auto bin = (uint64_t) llround(unmet / binWidth[site]);
+    uint64_t last = (uint64_t) llround(demands[site] / binWidth[site]);
+    return (uint32_t) min(bin, last);
+}
+
+ReliabilityResult ReliabilitySimulator::run(uint64_t numSamples, uint64_t seed) const {
+    size_t n = sites.size();
+    uint64_t numBlocks = (numSamples + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    ReliabilityResult result;
+    result.samples = numSamples;
+    result.sites.resize(n);
+
+    // Bins of width 1 when the demand is a small integer, so the percentiles are exact
+    vector<double> binWidth(n);
+    vector<uint32_t> numBins(n);
+    vector<double> baselineUnmet(n);
+    for(size_t i = 0; i < n; i++) {
+        double bins = min(max(ceil(demands[i]), 1.0), (double) MAX_BINS);
+        binWidth[i] = demands[i] > 0 ? demands[i] / bins : 1;
+        numBins[i] = (uint32_t) bins + 1;
+        baselineUnmet[i] = max(0.0, demands[i] - prototype.getIncomingFlow(sites[i]));
+        result.sites[i].demand = demands[i];
+        result.sites[i].baselineUnmet = baselineUnmet[i];
+    }
+    if(numSamples == 0) return result;
+
+    // The unmet demand of each block is summed separately and added up in block order, so the sums do not depend
+    // on the thread that simulated each block
+    vector<double> blockSums(numBlocks * n, 0);
+    vector<vector<uint64_t>> histogram(n);
+    for(size_t i = 0; i < n; i++) histogram[i].assign(numBins[i], 0);
+
+    atomic<uint64_t> next(0);
+    exception_ptr error = nullptr;
+    mutex mergeMutex;
+
+    auto work = [&]() {
+        try {
+            ResidualGraph rg = prototype;
+            vector<double> baselineFlows;
+            rg.saveFlows(baselineFlows);
+
+            vector<vector<uint64_t>> localHistogram(n);
+            for(size_t i = 0; i < n; i++) localHistogram[i].assign(numBins[i], 0);
+            uint64_t noOutage = 0, cached = 0, solved = 0;
+
+            unordered_map<string, vector<double>> cache;
+            vector<uint32_t> failed;
+            vector<double> unmet(n);
+            uniform_real_distribution<double> uniform(0.0, 1.0);
+
+            for(uint64_t b = next++; b < numBlocks; b = next++) {
+                seed_seq seq{(uint32_t) seed, (uint32_t) (seed >> 32), (uint32_t) b, (uint32_t) (b >> 32)};
+                mt19937_64 rng(seq);
+                uint64_t blockSamples = min(BLOCK_SIZE, numSamples - b * BLOCK_SIZE);
+                double *sums = &blockSums[b * n];
+
+                for(uint64_t s = 0; s < blockSamples; s++) {
+                    // Every component draws a number in every sample, so the draws of a component never depend on
+                    // the probabilities of the others
+                    failed.clear();
+                    for(uint32_t c = 0; c < components.size(); c++) {
+                        if(uniform(rng) < probabilities[c]) failed.push_back(c);
+                    }
+
+                    const vector<double> *sample = &baselineUnmet;
+
+                    if(failed.empty()) {
+                        noOutage++;
+                    }
+                    else {
+                        string key(reinterpret_cast<const char *>(failed.data()), failed.size() * sizeof(uint32_t));
+                        auto it = cache.find(key);
+
+                        if(it != cache.end()) {
+                            cached++;
+                            sample = &it->second;
+                        }
+                        else {
+                            // Cancel the flow of every failed component, then re-route what was lost in one solve
+                            for(uint32_t c : failed) {
+                                const FailureCase &f = components[c];
+                                if(f.vertex != NO_VERTEX) {
+                                    rg.cancelFlowThroughVertex(f.vertex);
+                                    rg.deactivateVertex(f.vertex);
+                                }
+                                else {
+                                    rg.cancelFlowThroughEdge(f.servicePointA, f.servicePointB, f.unidirectional);
+                                    rg.deactivateEdge(f.servicePointA, f.servicePointB, f.unidirectional);
+                                }
+                            }
+                            solver->solve(rg);
+                            solved++;
+
+                            for(size_t i = 0; i < n; i++) unmet[i] = max(0.0, demands[i] - rg.getIncomingFlow(sites[i]));
+
+                            rg.restoreFlows(baselineFlows);
+                            for(uint32_t c : failed) {
+                                const FailureCase &f = components[c];
+                                if(f.vertex != NO_VERTEX) rg.activateVertex(f.vertex);
+                                else rg.activateEdge(f.servicePointA, f.servicePointB, f.unidirectional);
+                            }
+
+                            sample = &unmet;
+                            if(cache.size() < CACHE_LIMIT) sample = &cache.emplace(std::move(key), unmet).first->second;
+                        }
+                    }
+
+                    for(size_t i = 0; i < n; i++) {
+                        sums[i] += (*sample)[i];
+                        localHistogram[i][getBin(i, (*sample)[i], binWidth)]++;
+                    }
+                }
+            }
+
+            lock_guard<mutex> lock(mergeMutex);
+            for(size_t i = 0; i < n; i++) {
+                for(uint32_t bin = 0; bin < numBins[i]; bin++) histogram[i][bin] += localHistogram[i][bin];
+            }
+            result.noOutage += noOutage;
+            result.cached += cached;
+            result.solved += solved;
+        }
+        catch(...) {
+            lock_guard<mutex> lock(mergeMutex);
+            if(error == nullptr) error = current_exception();
+            next = numBlocks;
+        }
+    };
+
+    size_t numWorkers = min<uint64_t>(numThreads, numBlocks);
+
+    if(numWorkers <= 1) {
+        work();
+    }
+    else {
+        vector<thread> threads;
+        threads.reserve(numWorkers);
+        for(size_t w = 0; w < numWorkers; w++) threads.emplace_back(work);
+        for(thread &t : threads) t.join();
+    }
+
+    if(error != nullptr) rethrow_exception(error);
+
+    for(size_t i = 0; i < n; i++) {
+        SiteReliability &site = result.sites[i];
+
+        double total = 0;
+        for(uint64_t b = 0; b < numBlocks; b++) total += blockSums[b * n + i];
+        site.expectedUnmet = total / (double) numSamples;
+
+        // The percentile is the smallest bin that holds at least that fraction of the samples
+        auto percentile = [&](double q) {
+            auto rank = (uint64_t) ceil(q * (double) numSamples);
+            uint64_t count = 0;
+            for(uint32_t bin = 0; bin < numBins[i]; bin++) {
+                count += histogram[i][bin];
+                if(count >= rank) return min(demands[i], bin * binWidth[i]);
+            }
+            return demands[i];
+        };
+        site.p50Unmet = percentile(0.50);
+        site.p95Unmet = percentile(0.95);
+        site.p99Unmet = percentile(0.99);
+    }
+    return result;
+}
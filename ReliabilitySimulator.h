@@ -0,0 +1,120 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_RELIABILITY_SIMULATOR_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_RELIABILITY_SIMULATOR_H
+
+
+#include <cstdint>
+#include <vector>
+#include "Graph.h"
+#include "ResidualGraph.h"
+#include "MaxFlowSolver.h"
+#include "FailureSweep.h"
+
+using namespace std;
+
+/**
+* @brief Unmet demand of one delivery site, aggregated over every sample of a reliability simulation.
+*/
+struct SiteReliability {
+    double demand = 0;
+    double baselineUnmet = 0;   // unmet demand without any outage
+    double expectedUnmet = 0;   // mean unmet demand over the samples
+    double p50Unmet = 0;        // percentiles of the unmet demand over the samples
+    double p95Unmet = 0;
+    double p99Unmet = 0;
+};
+
+/**
+* @brief Result of a reliability simulation.
+*/
+struct ReliabilityResult {
+    vector<SiteReliability> sites;  // one entry per delivery site, in the order they were given
+    uint64_t samples = 0;
+    uint64_t noOutage = 0;          // samples without any outage, answered by the baseline flow
+    uint64_t cached = 0;            // samples whose outage pattern was already solved by the same thread
+    uint64_t solved = 0;            // samples solved by the max-flow solver
+};
+
+/**
+* @brief Monte Carlo simulator of the unmet demand of a network under random outages.
+*
+* @details Every sample puts every component out of commission independently with its own failure probability, and
+* computes the max flow with the same semantics as Graph::stationOutOfCommission() and
+* Graph::pipelineOutOfCommission(): the baseline max flow is kept, only the flow going through the failed components is
+* cancelled, and the solver re-routes what was lost. The unmet demand of every delivery site is then aggregated.
+*
+* The samples are split into fixed blocks, and every block draws its outages from its own random generator seeded with
+* the seed of the simulation and the index of the block. So the outages of a sample depend only on the seed, which gives
+* common random numbers: two simulations with the same seed and components see the same outages, whatever the number of
+* threads, the solver or the capacities. Outage patterns repeat often when failure probabilities are small, so every
+* thread caches the unmet demand of the patterns it has solved, up to a bounded number of patterns.
+*/
+class ReliabilitySimulator {
+private:
+    static constexpr uint64_t BLOCK_SIZE = 4096;        // samples per block
+    static constexpr size_t CACHE_LIMIT = 1 << 16;      // outage patterns cached by each thread
+    static constexpr uint32_t MAX_BINS = 4096;          // histogram bins per delivery site
+
+    ResidualGraph prototype;
+    const MaxFlowSolver *solver;
+    vector<FailureCase> components;
+    vector<double> probabilities;
+    vector<uint32_t> sites;
+    vector<double> demands;
+    unsigned int numThreads;
+
+    /**
+     * @brief Get the histogram bin of an unmet demand.
+     *
+     * @param site The index of the delivery site.
+     * @param unmet The unmet demand.
+     * @param binWidth The width of the bins of each delivery site.
+     *
+     * @return The index of the bin.
+     *
+     * @complexity O(1).
+     */
+    [[nodiscard]] uint32_t getBin(size_t site, double unmet, const vector<double> &binWidth) const;
+
+public:
+
+    /**
+     * @brief Builds a simulator for the given graph.
+     *
+     * @details The current flow of the graph is taken as the baseline, so the graph must hold its max flow.
+     * Outages are repaired with the max-flow solver of the graph.
+     *
+     * @param g Pointer to the graph to be simulated.
+     * @param components The components that can fail, each one described by a failure case.
+     * @param probabilities The failure probability of each component, between 0 and 1.
+     * @param sites The vertex ids of the delivery sites.
+     * @param demands The demand of each delivery site.
+     * @param numThreads The number of worker threads, or 0 to use one per hardware thread.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    ReliabilitySimulator(Graph *g, vector<FailureCase> components, vector<double> probabilities,
+                         vector<uint32_t> sites, vector<double> demands, unsigned int numThreads);
+
+    /**
+     * @brief Runs the simulation.
+     *
+     * @details The expected unmet demand is exact for the samples drawn. The percentiles are taken from a histogram of
+     * at most MAX_BINS bins per delivery site, so they are exact when the demand is an integer not above MAX_BINS, and
+     * rounded to the width of a bin otherwise. The result only depends on the seed and the number of samples.
+     *
+     * @param numSamples The number of samples.
+     * @param seed The seed of the random generators.
+     *
+     * @return The aggregated unmet demand of every delivery site and the counters of the work done.
+     *
+     * @throws std::logic_error if the max-flow solver fails.
+     *
+     * @complexity O(S * (C + F) / T), where S is the number of samples, C is the number of components, F is the
+     * complexity of repairing the flow of the outages of one sample and T is the number of threads. Samples without
+     * outages or with a cached pattern cost no solve.
+     */
+    ReliabilityResult run(uint64_t numSamples, uint64_t seed) const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_RELIABILITY_SIMULATOR_H
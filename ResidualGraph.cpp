@@ -0,0 +1,434 @@
+#include <cstring>
+#include "ResidualGraph.h"
+
+ResidualGraph::ResidualGraph(Graph *g) {
+    const vector<Vertex *> &vertices = g->getVertexSet();
+    numVertices = (uint32_t) vertices.size();
+
+    // Count the arcs of each vertex: one per outgoing edge and one per incoming edge
+    firstArc.assign(numVertices + 1, 0);
+    for (uint32_t v = 0; v < numVertices; v++) {
+        firstArc[v + 1] = firstArc[v] + (int) (vertices[v]->getAdj().size() + vertices[v]->getIncoming().size());
+    }
+
+    int numArcs = firstArc[numVertices];
+    arcHead.resize(numArcs);
+    arcReverse.resize(numArcs);
+    arcCapacity.resize(numArcs);
+    arcFlow.resize(numArcs);
+    arcEdge.resize(numArcs);
+
+    // Lay out the forward arcs of the outgoing edges
+    unordered_map<const Edge *, int> forwardArcs;
+    forwardArcs.reserve(numArcs / 2);
+    for (uint32_t u = 0; u < numVertices; u++) {
+        int a = firstArc[u];
+        for (Edge *e : vertices[u]->getAdj()) {
+            forwardArcs.insert({e, a});
+            arcHead[a] = e->getDest()->getId();
+            arcCapacity[a] = e->getCapacity();
+            arcFlow[a] = e->getFlow();
+            arcEdge[a] = e;
+            a++;
+        }
+    }
+
+    // Lay out the reverse arcs of the incoming edges and pair them with their forward arcs
+    for (uint32_t v = 0; v < numVertices; v++) {
+        int a = firstArc[v] + (int) vertices[v]->getAdj().size();
+        for (Edge *e : vertices[v]->getIncoming()) {
+            int forward = forwardArcs.at(e);
+            arcHead[a] = e->getOrig()->getId();
+            arcCapacity[a] = 0;
+            arcFlow[a] = -e->getFlow();
+            arcEdge[a] = nullptr;
+            arcReverse[a] = forward;
+            arcReverse[forward] = a;
+            a++;
+        }
+    }
+
+    activeVertices.assign(numVertices, 1);
+    activeArcs.assign(numArcs, 1);
+
+    source = g->getMainSourceId();
+    target = g->getMainTargetId();
+}
+
+uint32_t ResidualGraph::getNumVertices() const {
+    return this->numVertices;
+}
+
+int ResidualGraph::getNumArcs() const {
+    return (int) this->arcHead.size();
+}
+
+uint32_t ResidualGraph::getSource() const {
+    return this->source;
+}
+
+uint32_t ResidualGraph::getTarget() const {
+    return this->target;
+}
+
+const vector<int> &ResidualGraph::getFirstArc() const {
+    return this->firstArc;
+}
+
+const vector<uint32_t> &ResidualGraph::getArcHeads() const {
+    return this->arcHead;
+}
+
+const vector<int> &ResidualGraph::getArcReverse() const {
+    return this->arcReverse;
+}
+
+const vector<double> &ResidualGraph::getArcCapacities() const {
+    return this->arcCapacity;
+}
+
+vector<double> &ResidualGraph::getArcFlows() {
+    return this->arcFlow;
+}
+
+void ResidualGraph::saveFlows(vector<double> &flows) const {
+    flows.resize(arcFlow.size());
+    if(!arcFlow.empty()) memcpy(flows.data(), arcFlow.data(), arcFlow.size() * sizeof(double));
+}
+
+void ResidualGraph::restoreFlows(const vector<double> &flows) {
+    if(!arcFlow.empty()) memcpy(arcFlow.data(), flows.data(), arcFlow.size() * sizeof(double));
+}
+
+const vector<char> &ResidualGraph::getActiveVertices() const {
+    return this->activeVertices;
+}
+
+const vector<char> &ResidualGraph::getActiveArcs() const {
+    return this->activeArcs;
+}
+
+void ResidualGraph::deactivateVertex(uint32_t v) {
+    if (v < numVertices) activeVertices[v] = 0;
+}
+
+void ResidualGraph::deactivateEdge(uint32_t orig, uint32_t dest, bool unidirectional) {
+    if (orig >= numVertices || dest >= numVertices) return;
+
+    // Deactivate both arcs of every edge from 'orig' to 'dest' (and from 'dest' to 'orig' if bidirectional)
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest) {
+            activeArcs[a] = 0;
+            activeArcs[arcReverse[a]] = 0;
+        }
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig) {
+                activeArcs[a] = 0;
+                activeArcs[arcReverse[a]] = 0;
+            }
+        }
+    }
+}
+
+void ResidualGraph::activateVertex(uint32_t v) {
+    if (v < numVertices) activeVertices[v] = 1;
+}
+
+void ResidualGraph::activateEdge(uint32_t orig, uint32_t dest, bool unidirectional) {
+    if (orig >= numVertices || dest >= numVertices) return;
+
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest) {
+            activeArcs[a] = 1;
+            activeArcs[arcReverse[a]] = 1;
+        }
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig) {
+                activeArcs[a] = 1;
+                activeArcs[arcReverse[a]] = 1;
+            }
+        }
+    }
+}
+
+void ResidualGraph::getEdgeArcs(uint32_t orig, uint32_t dest, bool unidirectional, vector<int> &arcs) const {
+    arcs.clear();
+    if (orig >= numVertices || dest >= numVertices) return;
+
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest) arcs.push_back(a);
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig) arcs.push_back(a);
+        }
+    }
+}
+
+void ResidualGraph::activateArc(int a) {
+    activeArcs[a] = 1;
+    activeArcs[arcReverse[a]] = 1;
+}
+
+void ResidualGraph::scaleEdgeCapacity(uint32_t orig, uint32_t dest, bool unidirectional, double factor) {
+    if (orig >= numVertices || dest >= numVertices) return;
+
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest) arcCapacity[a] = arcEdge[a]->getCapacity() * factor;
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig) arcCapacity[a] = arcEdge[a]->getCapacity() * factor;
+        }
+    }
+}
+
+uint32_t ResidualGraph::findFlowPath(uint32_t from, uint32_t to, uint32_t alternative, bool forward) {
+    parentArc.assign(numVertices, -1);
+    bfsQueue.resize(numVertices);
+
+    // The start vertex is marked with its own first arc, so it is never visited again
+    parentArc[from] = firstArc[from];
+    int head = 0, tail = 0;
+    bfsQueue[tail++] = from;
+
+    while (head < tail) {
+        uint32_t v = bfsQueue[head++];
+        for (int b = firstArc[v]; b < firstArc[v + 1]; b++) {
+            // Forward searches follow the forward arcs, backward searches follow the reverse arcs
+            if ((arcEdge[b] != nullptr) != forward) continue;
+
+            // 'a' is the forward arc of the edge, which must carry flow
+            int a = forward ? b : arcReverse[b];
+            if (arcFlow[a] <= 0) continue;
+
+            uint32_t w = arcHead[b];
+            if (w == to || w == alternative) {
+                parentArc[w] = a;
+                return w;
+            }
+            if (parentArc[w] == -1) {
+                parentArc[w] = a;
+                bfsQueue[tail++] = w;
+            }
+        }
+    }
+    return NO_VERTEX;
+}
+
+void ResidualGraph::cancelFlowThroughArc(int a) {
+    uint32_t tail = arcHead[arcReverse[a]];
+    uint32_t head = arcHead[a];
+    vector<int> path;
+
+    while (arcFlow[a] > 0) {
+        path.clear();
+        path.push_back(a);
+
+        // Follow the flow from the head of the arc back to its tail, closing a cycle, or else to the target.
+        // Looking for the cycle first guarantees that the path to the target and the path from the source share no
+        // vertex, so no arc is used twice
+        uint32_t end = findFlowPath(head, tail, tail, true);
+        if (end == NO_VERTEX) end = head == target ? target : findFlowPath(head, target, target, true);
+        if (end == NO_VERTEX) break;
+        for (uint32_t v = end; v != head; v = arcHead[arcReverse[parentArc[v]]]) path.push_back(parentArc[v]);
+
+        // If it reached the target, follow the flow backwards from the tail of the arc until it reaches the source
+        if (end == target && tail != source) {
+            if (findFlowPath(tail, source, source, false) == NO_VERTEX) break;
+            for (uint32_t v = source; v != tail; v = arcHead[parentArc[v]]) path.push_back(parentArc[v]);
+        }
+
+        // Remove the minimum flow along the path or cycle
+        double f = INF;
+        for (int p : path) f = std::min(f, arcFlow[p]);
+        for (int p : path) {
+            arcFlow[p] -= f;
+            arcFlow[arcReverse[p]] += f;
+        }
+    }
+}
+
+void ResidualGraph::cancelFlowThroughVertex(uint32_t v) {
+    if (v >= numVertices || v == source || v == target) return;
+
+    // All the flow going through the vertex leaves it through its outgoing edges
+    for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+        if (arcEdge[a] != nullptr) cancelFlowThroughArc(a);
+    }
+}
+
+void ResidualGraph::cancelFlowThroughEdge(uint32_t orig, uint32_t dest, bool unidirectional) {
+    if (orig >= numVertices || dest >= numVertices) return;
+
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest) cancelFlowThroughArc(a);
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig) cancelFlowThroughArc(a);
+        }
+    }
+}
+
+double ResidualGraph::getSuppliedFlow() const {
+    double supplied = 0;
+    if (target >= numVertices) return supplied;
+
+    // The reverse arcs of the target lead to the vertices with an edge to it
+    for (int a = firstArc[target]; a < firstArc[target + 1]; a++) {
+        if (arcEdge[a] == nullptr) supplied += getIncomingFlow(arcHead[a]);
+    }
+    return supplied;
+}
+
+void ResidualGraph::findSourceSide(vector<char> &reachable) const {
+    reachable.assign(numVertices, 0);
+    if (source >= numVertices || !activeVertices[source]) return;
+
+    vector<uint32_t> queue;
+    queue.reserve(numVertices);
+    queue.push_back(source);
+    reachable[source] = 1;
+
+    for (size_t i = 0; i < queue.size(); i++) {
+        uint32_t v = queue[i];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            uint32_t w = arcHead[a];
+            if (reachable[w] || !activeArcs[a] || !activeVertices[w]) continue;
+            if (arcCapacity[a] - arcFlow[a] <= 0) continue;
+            reachable[w] = 1;
+            queue.push_back(w);
+        }
+    }
+}
+
+bool ResidualGraph::hasFlowThroughEdge(uint32_t orig, uint32_t dest, bool unidirectional) const {
+    if (orig >= numVertices || dest >= numVertices) return false;
+
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest && arcFlow[a] > 0) return true;
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig && arcFlow[a] > 0) return true;
+        }
+    }
+    return false;
+}
+
+bool ResidualGraph::isCutEdge(uint32_t orig, uint32_t dest, bool unidirectional, const vector<char> &sourceSide) const {
+    if (orig >= numVertices || dest >= numVertices) return false;
+
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] == nullptr || arcHead[a] != dest || arcFlow[a] <= 0) continue;
+        if (!sourceSide[orig] || sourceSide[dest]) return false;
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] == nullptr || arcHead[a] != orig || arcFlow[a] <= 0) continue;
+            if (!sourceSide[dest] || sourceSide[orig]) return false;
+        }
+    }
+    return true;
+}
+
+double ResidualGraph::getCutCapacity(uint32_t v, const vector<char> &sourceSide) const {
+    double capacity = 0;
+    if (v >= numVertices) return capacity;
+
+    for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+        uint32_t w = arcHead[a];
+        if (arcEdge[a] != nullptr) {
+            if (sourceSide[v] && !sourceSide[w]) capacity += arcCapacity[a];
+        }
+        else if (sourceSide[w] && !sourceSide[v]) {
+            capacity += arcCapacity[arcReverse[a]];
+        }
+    }
+    return capacity;
+}
+
+bool ResidualGraph::findBypass(uint32_t orig, uint32_t dest, bool unidirectional, const vector<char> &blocked) const {
+    if (orig >= numVertices || dest >= numVertices) return false;
+
+    double forwardFlow = 0, backwardFlow = 0;
+    for (int a = firstArc[orig]; a < firstArc[orig + 1]; a++) {
+        if (arcEdge[a] != nullptr && arcHead[a] == dest) forwardFlow += arcFlow[a];
+    }
+    if (!unidirectional) {
+        for (int a = firstArc[dest]; a < firstArc[dest + 1]; a++) {
+            if (arcEdge[a] != nullptr && arcHead[a] == orig) backwardFlow += arcFlow[a];
+        }
+    }
+    if (forwardFlow > 0 && backwardFlow > 0) return false;
+    if (forwardFlow <= 0 && backwardFlow <= 0) return true;
+
+    uint32_t from = forwardFlow > 0 ? orig : dest;
+    uint32_t to = forwardFlow > 0 ? dest : orig;
+    double flow = max(forwardFlow, backwardFlow);
+
+    // An arc between the two vertices belongs to the failed edges if its edge goes from 'orig' to 'dest', or either
+    // way when they are bidirectional
+    auto isFailedArc = [&](uint32_t tail, int a) {
+        uint32_t head = arcHead[a];
+        if (!((tail == orig && head == dest) || (tail == dest && head == orig))) return false;
+        uint32_t edgeOrig = arcEdge[a] != nullptr ? tail : head;
+        return edgeOrig == orig || !unidirectional;
+    };
+
+    vector<char> visited(numVertices, 0);
+    vector<uint32_t> queue;
+    queue.push_back(from);
+    visited[from] = 1;
+
+    for (size_t i = 0; i < queue.size(); i++) {
+        uint32_t v = queue[i];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            uint32_t w = arcHead[a];
+            if (visited[w] || !activeArcs[a] || !activeVertices[w]) continue;
+            if (arcCapacity[a] - arcFlow[a] < flow || isFailedArc(v, a)) continue;
+            if (arcEdge[a] == nullptr && (blocked[v] || blocked[w])) continue;
+
+            if (w == to) return true;
+            if (w == source || w == target || blocked[w]) continue;
+
+            visited[w] = 1;
+            queue.push_back(w);
+        }
+    }
+    return false;
+}
+
+void ResidualGraph::findCutEdges(const vector<char> &sourceSide, vector<pair<uint32_t, uint32_t>> &edges) const {
+    edges.clear();
+
+    for (uint32_t v = 0; v < numVertices; v++) {
+        if (!sourceSide[v] || !activeVertices[v]) continue;
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            uint32_t w = arcHead[a];
+            if (arcEdge[a] == nullptr || arcCapacity[a] <= 0 || sourceSide[w] || !activeArcs[a] || !activeVertices[w]) continue;
+            edges.emplace_back(v, w);
+        }
+    }
+}
+
+double ResidualGraph::getIncomingFlow(uint32_t v) const {
+    double flow = 0;
+
+    // The reverse arcs of the incoming edges hold their negated flow
+    for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+        if (arcEdge[a] == nullptr) flow -= arcFlow[a];
+    }
+    return flow;
+}
+
+void ResidualGraph::writeFlows() const {
+    for (int a = 0; a < getNumArcs(); a++) {
+        if (arcEdge[a] != nullptr) arcEdge[a]->setFlow(arcFlow[a]);
+    }
+}
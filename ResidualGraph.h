@@ -0,0 +1,421 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_RESIDUAL_GRAPH_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_RESIDUAL_GRAPH_H
+
+
+#include <vector>
+#include <unordered_map>
+#include "Graph.h"
+
+using namespace std;
+
+/**
+* @brief Compressed-sparse-row (CSR) residual graph used by the max-flow algorithms.
+*
+* @details Every Edge of the Graph is represented by a pair of arcs stored in contiguous arrays: a forward arc
+* with the edge capacity and a reverse arc with capacity 0, each one knowing the index of its pair. Vertices are
+* identified by the same dense ids as in the Graph and the arcs leaving vertex 'v' are stored in the range
+* [firstArc[v], firstArc[v + 1]).
+* Inside that range the forward arcs of the outgoing edges come first, followed by the reverse arcs of the incoming
+* edges, in the same order as Vertex::getAdj() and Vertex::getIncoming(), so traversals visit the same neighbours
+* in the same order as they would on the Graph itself.
+*/
+class ResidualGraph {
+private:
+    uint32_t numVertices = 0;
+    uint32_t source = NO_VERTEX;
+    uint32_t target = NO_VERTEX;
+
+    vector<int> firstArc;       // arcs of vertex v are [firstArc[v], firstArc[v + 1])
+    vector<uint32_t> arcHead;   // destination vertex of each arc
+    vector<int> arcReverse;     // index of the paired arc
+    vector<double> arcCapacity; // capacity of each arc (0 for reverse arcs)
+    vector<double> arcFlow;     // flow of each arc (reverse arcs hold the negated flow)
+    vector<Edge *> arcEdge;     // edge represented by each forward arc, nullptr for reverse arcs
+
+    vector<char> activeVertices; // vertices that can be used by the max-flow algorithms
+    vector<char> activeArcs;     // arcs that can be used by the max-flow algorithms
+
+    vector<int> parentArc;       // BFS buffers used to cancel flow
+    vector<uint32_t> bfsQueue;
+
+    /**
+     * @brief Finds a path of arcs carrying flow between two vertices using Breadth-First Search.
+     *
+     * @details If 'forward' is true, the search follows the forward arcs with positive flow leaving each vertex,
+     * starting at 'from', until it reaches 'to' or 'alternative'. Otherwise, it follows the forward arcs with
+     * positive flow entering each vertex backwards. The arc through which each vertex was reached is saved in
+     * parentArc.
+     *
+     * @param from The id of the vertex where the search starts.
+     * @param to The id of the first vertex that ends the search.
+     * @param alternative The id of the second vertex that ends the search.
+     * @param forward Flag indicating whether the flow is followed forwards or backwards.
+     *
+     * @return The id of the vertex that ended the search, or NO_VERTEX if neither was reached.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    uint32_t findFlowPath(uint32_t from, uint32_t to, uint32_t alternative, bool forward);
+
+    /**
+     * @brief Cancels all the flow going through a forward arc.
+     *
+     * @details While the arc carries flow, this function finds a flow path from the head of the arc to the target
+     * and a flow path from the source to the tail of the arc, or a flow cycle that goes back to the tail of the arc,
+     * and removes the minimum flow along it. Only the flow routed through the arc is removed, so the remaining flow
+     * stays valid and every other path keeps its flow.
+     *
+     * @param a The index of the forward arc.
+     *
+     * @complexity O(k * (V + E)), where k is the number of flow paths and cycles going through the arc.
+     */
+    void cancelFlowThroughArc(int a);
+
+public:
+
+    /**
+     * @brief Builds the residual graph of the given graph.
+     *
+     * @details This constructor lays out the forward and reverse arcs of every edge of the graph in contiguous
+     * arrays, pairing each arc with its reverse. The current flow of every edge is copied into the residual
+     * graph, so the max-flow algorithms continue from the current state.
+     * The main source and the main target of the graph, if present, become the source and the target of the
+     * residual graph. All vertices and arcs start active.
+     *
+     * @param g Pointer to the graph to be represented.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    explicit ResidualGraph(Graph *g);
+
+    /**
+     * @brief Get the number of vertices.
+     *
+     * @return The number of vertices of the residual graph.
+     */
+    [[nodiscard]] uint32_t getNumVertices() const;
+
+    /**
+     * @brief Get the number of arcs.
+     *
+     * @return The number of arcs of the residual graph, which is twice the number of edges of the graph.
+     */
+    [[nodiscard]] int getNumArcs() const;
+
+    /**
+     * @brief Get the id of the source vertex (the main source of the graph).
+     *
+     * @return The id of the source vertex, or NO_VERTEX if the graph has no main source.
+     */
+    [[nodiscard]] uint32_t getSource() const;
+
+    /**
+     * @brief Get the id of the target vertex (the main target of the graph).
+     *
+     * @return The id of the target vertex, or NO_VERTEX if the graph has no main target.
+     */
+    [[nodiscard]] uint32_t getTarget() const;
+
+    /**
+     * @brief Get the offsets of the arcs of each vertex.
+     *
+     * @return Vector with V + 1 entries, where the arcs of vertex 'v' are [firstArc[v], firstArc[v + 1]).
+     */
+    [[nodiscard]] const vector<int> &getFirstArc() const;
+
+    /**
+     * @brief Get the destination vertex of each arc.
+     *
+     * @return Vector with the id of the destination vertex of each arc.
+     */
+    [[nodiscard]] const vector<uint32_t> &getArcHeads() const;
+
+    /**
+     * @brief Get the paired reverse arc of each arc.
+     *
+     * @return Vector with the index of the reverse arc of each arc.
+     */
+    [[nodiscard]] const vector<int> &getArcReverse() const;
+
+    /**
+     * @brief Get the capacity of each arc.
+     *
+     * @return Vector with the capacity of each arc.
+     */
+    [[nodiscard]] const vector<double> &getArcCapacities() const;
+
+    /**
+     * @brief Get the flow of each arc, allowing it to be modified.
+     *
+     * @details The flow of a reverse arc is always the negated flow of its pair, so the residual capacity of
+     * any arc 'a' is getArcCapacities()[a] - getArcFlows()[a].
+     *
+     * @return Reference to the vector with the flow of each arc.
+     */
+    vector<double> &getArcFlows();
+
+    /**
+     * @brief Saves the flow of every arc.
+     *
+     * @details The topology of the residual graph never changes, so its flow state is a single array that is
+     * copied as one block. 'flows' is only reallocated the first time it is used.
+     *
+     * @param flows Vector where the flow of each arc is saved.
+     *
+     * @complexity O(E), where E is the number of edges in the graph.
+     */
+    void saveFlows(vector<double> &flows) const;
+
+    /**
+     * @brief Restores the flow of every arc, previously saved with saveFlows().
+     *
+     * @param flows Vector with the flow of each arc.
+     *
+     * @complexity O(E), where E is the number of edges in the graph.
+     */
+    void restoreFlows(const vector<double> &flows);
+
+    /**
+     * @brief Get the active state of each vertex.
+     *
+     * @return Vector where non-zero entries mark the vertices that can be visited.
+     */
+    [[nodiscard]] const vector<char> &getActiveVertices() const;
+
+    /**
+     * @brief Get the active state of each arc.
+     *
+     * @return Vector where non-zero entries mark the arcs that can be used.
+     */
+    [[nodiscard]] const vector<char> &getActiveArcs() const;
+
+    /**
+     * @brief Deactivates a vertex so that the max-flow algorithms never visit it.
+     *
+     * @param v The id of the vertex to be deactivated.
+     *
+     * @complexity O(1).
+     */
+    void deactivateVertex(uint32_t v);
+
+    /**
+     * @brief Deactivates the arcs of the edges between two vertices.
+     *
+     * @details This function deactivates both arcs of every edge going from 'orig' to 'dest'. If the pipeline is
+     * bidirectional, the arcs of the edges going from 'dest' to 'orig' are deactivated as well.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are deactivated.
+     *
+     * @complexity O(d), where d is the number of arcs of 'orig' and 'dest'.
+     */
+    void deactivateEdge(uint32_t orig, uint32_t dest, bool unidirectional);
+
+    /**
+     * @brief Activates a vertex deactivated by deactivateVertex.
+     *
+     * @param v The id of the vertex to be activated.
+     *
+     * @complexity O(1).
+     */
+    void activateVertex(uint32_t v);
+
+    /**
+     * @brief Activates the arcs of the edges between two vertices deactivated by deactivateEdge.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are activated.
+     *
+     * @complexity O(d), where d is the number of arcs of 'orig' and 'dest'.
+     */
+    void activateEdge(uint32_t orig, uint32_t dest, bool unidirectional);
+
+    /**
+     * @brief Get the forward arcs of the edges between two vertices, which are the arcs deactivateEdge acts on.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are included.
+     * @param arcs Vector where the indexes of the forward arcs are written, replacing its contents.
+     *
+     * @complexity O(d), where d is the number of arcs of 'orig' and 'dest'.
+     */
+    void getEdgeArcs(uint32_t orig, uint32_t dest, bool unidirectional, vector<int> &arcs) const;
+
+    /**
+     * @brief Activates a forward arc and its reverse arc.
+     *
+     * @param a The index of the forward arc.
+     *
+     * @complexity O(1).
+     */
+    void activateArc(int a);
+
+    /**
+     * @brief Sets the capacity of the edges between two vertices to their capacity in the graph times a factor.
+     *
+     * @details The flow is not changed, so the factor must leave room for the current flow of the edges.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are scaled.
+     * @param factor The factor applied to the capacity of the edges, 0 to close them.
+     *
+     * @complexity O(d), where d is the number of arcs of 'orig' and 'dest'.
+     */
+    void scaleEdgeCapacity(uint32_t orig, uint32_t dest, bool unidirectional, double factor);
+
+    /**
+     * @brief Cancels the flow going through a vertex, keeping the rest of the flow valid.
+     *
+     * @details The flow of every path and cycle going through the vertex is removed, while the flow of the paths
+     * that do not use it is kept, so a max-flow algorithm only has to re-route the flow that was lost.
+     *
+     * @param v The id of the vertex, which must not be the source or the target.
+     *
+     * @complexity O(k * (V + E)), where k is the number of flow paths and cycles going through the vertex.
+     */
+    void cancelFlowThroughVertex(uint32_t v);
+
+    /**
+     * @brief Cancels the flow going through the edges between two vertices, keeping the rest of the flow valid.
+     *
+     * @details The flow of every path and cycle using an edge from 'orig' to 'dest' (and from 'dest' to 'orig' if the
+     * pipeline is bidirectional) is removed, while the flow of the paths that do not use those edges is kept.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are considered.
+     *
+     * @complexity O(k * (V + E)), where k is the number of flow paths and cycles going through the edges.
+     */
+    void cancelFlowThroughEdge(uint32_t orig, uint32_t dest, bool unidirectional);
+
+    /**
+     * @brief Get the flow entering a vertex.
+     *
+     * @param v The id of the vertex.
+     *
+     * @return The sum of the flow of the edges entering the vertex.
+     *
+     * @complexity O(d), where d is the number of arcs of the vertex.
+     */
+    [[nodiscard]] double getIncomingFlow(uint32_t v) const;
+
+    /**
+     * @brief Get the water supplied to the vertices linked to the target.
+     *
+     * @details Every delivery site is linked to the main target, so this is the sum of the incoming flow of every
+     * delivery site, as Graph::getTotalDemandAndMaxFlow() computes it.
+     *
+     * @return The sum of the incoming flow of every vertex with an edge to the target.
+     *
+     * @complexity O(E), where E is the number of edges in the graph.
+     */
+    [[nodiscard]] double getSuppliedFlow() const;
+
+    /**
+     * @brief Finds the vertices reachable from the source in the residual graph.
+     *
+     * @details Only active vertices and active arcs with residual capacity are used. When the flow is a max flow,
+     * the reachable vertices are the source side of a minimum cut.
+     *
+     * @param reachable Vector where the entry of each reachable vertex is set to 1 and every other entry to 0.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void findSourceSide(vector<char> &reachable) const;
+
+    /**
+     * @brief Checks whether the edges between two vertices carry any flow.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are considered.
+     *
+     * @return True if any of the edges has a positive flow, false otherwise.
+     *
+     * @complexity O(d), where d is the number of arcs of 'orig' and 'dest'.
+     */
+    [[nodiscard]] bool hasFlowThroughEdge(uint32_t orig, uint32_t dest, bool unidirectional) const;
+
+    /**
+     * @brief Checks whether all the flow through the edges between two vertices crosses a minimum cut.
+     *
+     * @details An edge with flow crosses the cut if its origin is on the source side and its destination is not,
+     * which means it is saturated. If the flow is a max flow and every edge with flow crosses the cut, removing
+     * those edges lowers the max flow by exactly their flow, so once the flow through them is cancelled the
+     * remaining flow is already a max flow and nothing can be re-routed.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are considered.
+     * @param sourceSide The source side of a minimum cut, as found by findSourceSide().
+     *
+     * @return True if every edge with flow crosses the cut, false otherwise.
+     *
+     * @complexity O(d), where d is the number of arcs of 'orig' and 'dest'.
+     */
+    [[nodiscard]] bool isCutEdge(uint32_t orig, uint32_t dest, bool unidirectional, const vector<char> &sourceSide) const;
+
+    /**
+     * @brief Get the capacity of the edges of a vertex that cross a minimum cut.
+     *
+     * @details An outgoing edge crosses the cut if the vertex is on the source side and its destination is not, and an
+     * incoming edge crosses it if its origin is on the source side and the vertex is not.
+     *
+     * @param v The id of the vertex.
+     * @param sourceSide The source side of a minimum cut, as found by findSourceSide().
+     *
+     * @return The sum of the capacity of the edges of the vertex that cross the cut.
+     *
+     * @complexity O(d), where d is the number of arcs of the vertex.
+     */
+    [[nodiscard]] double getCutCapacity(uint32_t v, const vector<char> &sourceSide) const;
+
+    /**
+     * @brief Checks whether the flow through the edges between two vertices fits in a residual path around them.
+     *
+     * @details The flow must go in a single direction. The path goes from the vertex the flow leaves to the vertex it
+     * enters, uses no arc of those edges, and every arc of the path has a residual capacity of at least that flow. The
+     * path never goes through the source, the target or a blocked vertex, and it only uses reverse arcs, which cancel
+     * flow, between vertices that are not blocked. Moving the flow to such a path therefore keeps the incoming flow of
+     * every blocked vertex.
+     *
+     * @param orig The id of the origin vertex.
+     * @param dest The id of the destination vertex.
+     * @param unidirectional Flag indicating whether only the edges from 'orig' to 'dest' are considered.
+     * @param blocked Entry of each vertex whose incoming flow must be kept set to 1.
+     *
+     * @return True if the edges carry no flow or such a path exists, false otherwise.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    [[nodiscard]] bool findBypass(uint32_t orig, uint32_t dest, bool unidirectional, const vector<char> &blocked) const;
+
+    /**
+     * @brief Finds the edges that cross a cut.
+     *
+     * @details Only active arcs between active vertices are considered. When the source side was found by
+     * findSourceSide() on a max flow, these edges are saturated and their capacities add up to the max flow.
+     *
+     * @param sourceSide The source side of the cut, as found by findSourceSide().
+     * @param edges Vector where the origin and destination of every edge from the source side to the other side are
+     * stored.
+     *
+     * @complexity O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void findCutEdges(const vector<char> &sourceSide, vector<pair<uint32_t, uint32_t>> &edges) const;
+
+    /**
+     * @brief Writes the flow of every forward arc back into the corresponding Edge of the graph.
+     *
+     * @complexity O(E), where E is the number of edges in the graph.
+     */
+    void writeFlows() const;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_RESIDUAL_GRAPH_H
@@ -0,0 +1,57 @@
+#include "States/MainMenuState.h"
+#include "ContingencyMenuState.h"
+#include "States/Utils/GetReliabilityParametersState.h"
+
+ContingencyMenuState::ContingencyMenuState() = default;
+
+void ContingencyMenuState::display() const {
+    cout << "\033[32m";
+    cout << "==== CONTINGENCY ANALYSIS ====" << endl;
+    cout << "\033[0m";
+    cout << "   1. Double Failures (N-2)   " << endl;
+    cout << "   2. Triple Failures (N-3)   " << endl;
+    cout << "   3. Monte Carlo Reliability \n" << endl;
+
+    cout << "   q. Main Menu              " << endl;
+    cout << "\033[32m";
+    cout << "-----------------------------" << endl;
+    cout << "\033[0m";
+    cout << "Enter your choice: ";
+}
+
+void ContingencyMenuState::handleInput(App* app) {
+    string choice;
+    cin >> choice;
+
+    if (choice.size() == 1) {
+        switch (choice[0]) {
+            case '1':
+                app->getData()->contingencyAnalysis(2);
+                PressEnterToContinue();
+                app->setState(this);
+                break;
+            case '2':
+                app->getData()->contingencyAnalysis(3);
+                PressEnterToContinue();
+                app->setState(this);
+                break;
+            case '3':
+                app->setState(new GetReliabilityParametersState(this, [&](App *app, uint64_t samples, double pReservoir,
+                                                                         double pStation, double pPipeline) {
+                    app->getData()->reliabilitySimulation(samples, pReservoir, pStation, pPipeline);
+                    PressEnterToContinue(1);
+                    app->setState(this);
+                }));
+                break;
+            case 'q':
+                app->setState(new MainMenuState());
+                break;
+            default:
+                cout << "\033[31m" << "Invalid choice. Please try again." << "\033[0m"  << endl;
+        }
+    } else  {
+        cout << "\033[31m";
+        cout << "Invalid input. Please enter a single character." << endl;
+        cout << "\033[0m";
+    }
+}
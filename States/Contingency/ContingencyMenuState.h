@@ -0,0 +1,46 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_CONTINGENCY_MENU_STATE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_CONTINGENCY_MENU_STATE_H
+
+
+#include "States/State.h"
+
+/**
+* @brief Class representing the Contingency Analysis Menu state of the water supply analysis system.
+*/
+
+class ContingencyMenuState : public State {
+public:
+
+    /**
+    * @brief Default constructor for ContingencyMenuState.
+    *
+    * @details This constructor initializes an instance of the ContingencyMenuState class. It doesn't require any
+    * parameters, as it represents the Contingency Analysis Menu state of the application, allowing users to choose the
+    * number of simultaneous failures to analyze.
+    */
+    ContingencyMenuState();
+
+    /**
+    * @brief Displays the Contingency Analysis Menu options.
+    *
+    * @details This method prints the Contingency Analysis Menu options to the console. Users input a single character
+    * corresponding to their desired option (1-2 for the number of simultaneous failures, 3 for a
+    * Monte Carlo reliability simulation, 'q' to go back to the Main Menu).
+    */
+    void display() const override;
+
+    /**
+    * @brief Handles user input for the Contingency Analysis Menu.
+    *
+    * @details This method prompts the user to input a single character representing their choice. If the input is
+    * valid, the contingency analysis of double (N-2) or triple (N-3) failures of the loaded network is run, or the
+    * parameters of a Monte Carlo reliability simulation are asked for. If the input is invalid, the method notifies the
+    * user and prompts them to try again. The 'q' option goes back to the Main Menu.
+    *
+    * @param app A pointer to the application instance.
+    */
+    void handleInput(App* app) override;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_CONTINGENCY_MENU_STATE_H
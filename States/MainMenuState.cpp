@@ -3,6 +3,8 @@
 #include "States/PumpingStationImpact/PumpingStationImpactMenuState.h"
 #include "States/PipelineImpact/PipelineImpactMenuState.h"
 #include "States/ReservoirImpact/ReservoirImpactMenuState.h"
+#include "States/Solver/SolverMenuState.h"
+#include "States/Contingency/ContingencyMenuState.h"
 #include "States/Utils/GetFilesPathState.h"
 
 MainMenuState::MainMenuState() = default;
@@ -17,7 +19,10 @@ void MainMenuState::display() const {
     cout << "   4. Load Optimization       " << endl;
     cout << "   5. Reservoir Impact        " << endl;
     cout << "   6. Pumping Station Impact  " << endl;
-    cout << "   7. Pipeline Failure Impact \n" << endl;
+    cout << "   7. Pipeline Failure Impact " << endl;
+    cout << "   8. Max Flow Solver         " << endl;
+    cout << "   9. Contingency Analysis    " << endl;
+    cout << "   s. Save Network Snapshot   \n" << endl;
 
     cout << "   q. Exit           " << endl;
     cout << "\033[32m";
@@ -40,6 +45,9 @@ void MainMenuState::handleInput(App* app) {
                         app->setState(this);
                     }));
                     break;
+                case '8':
+                    app->setState(new SolverMenuState());
+                    break;
                 case 'q':
                     cout << "\033[32m";
                     cout << "========================================" << endl;
@@ -89,6 +97,16 @@ void MainMenuState::handleInput(App* app) {
                     case '7':
                         app->setState(new PipelineImpactMenuState());
                         break;
+                    case '8':
+                        app->setState(new SolverMenuState());
+                        break;
+                    case '9':
+                        app->setState(new ContingencyMenuState());
+                        break;
+                    case 's':
+                        app->getData()->saveNetworkSnapshot();
+                        PressEnterToContinue();
+                        break;
                     case 'q':
                         cout << "\033[32m";
                         cout << "========================================" << endl;
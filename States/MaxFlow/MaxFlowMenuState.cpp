@@ -1,6 +1,7 @@
 #include "States/MainMenuState.h"
 #include "MaxFlowMenuState.h"
 #include "States/Utils/GetCityState.h"
+#include "States/Utils/GetReservoirState.h"
 
 MaxFlowMenuState::MaxFlowMenuState() = default;
 
@@ -9,7 +10,9 @@ void MaxFlowMenuState::display() const {
     cout << "==== FIND MAX WATER FLOW ====" << endl;
     cout << "\033[0m";
     cout << "   1. Select Specific City   " << endl;
-    cout << "   2. All Cities             \n" << endl;
+    cout << "   2. All Cities             " << endl;
+    cout << "   3. Reservoir to City      " << endl;
+    cout << "   4. Max Demand Growth      \n" << endl;
 
     cout << "   q. Main Menu              " << endl;
     cout << "\033[32m";
@@ -35,6 +38,19 @@ void MaxFlowMenuState::handleInput(App* app) {
                 app->getData()->allCitiesMaxFlow();
                 PressEnterToContinue();
                 break;
+            case '3':
+                app->setState(new GetReservoirState(this, [&](App *app, const string& reservoirCode) {
+                    app->setState(new GetCityState(this, [&, reservoirCode](App *app, const string& cityCode) {
+                        app->getData()->reservoirCityMaxFlow(reservoirCode, cityCode);
+                        PressEnterToContinue(1);
+                        app->setState(this);
+                    }));
+                }));
+                break;
+            case '4':
+                app->getData()->maxDemandGrowth();
+                PressEnterToContinue();
+                break;
             case 'q':
                 app->setState(new MainMenuState());
                 break;
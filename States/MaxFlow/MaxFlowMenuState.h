@@ -24,7 +24,7 @@ public:
     * @brief Displays the Find Max Water Flow Menu options.
     *
     * @details This method prints the Find Max Water Flow Menu options to the console, allowing users to choose from different
-    * functionalities. Users input a single character corresponding to their desired option (1-2 for sections, 'q' to exit).
+    * functionalities. Users input a single character corresponding to their desired option (1-4 for sections, 'q' to exit).
     * The method provides a visual representation of the Find Max Water Flow Menu and prompts the user to enter their choice.
     */
     void display() const override;
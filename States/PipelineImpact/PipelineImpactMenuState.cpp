@@ -10,7 +10,8 @@ void PipelineImpactMenuState::display() const {
     cout << "\033[0m";
     cout << "   1. Essential             " << endl;
     cout << "   2. Specific Pipeline     " << endl;
-    cout << "   3. All Pipelines       \n" << endl;
+    cout << "   3. All Pipelines         " << endl;
+    cout << "   4. Capacity Degradation  \n" << endl;
 
     cout << "   q. Main Menu              " << endl;
     cout << "\033[32m";
@@ -42,6 +43,13 @@ void PipelineImpactMenuState::handleInput(App* app) {
                 PressEnterToContinue();
                 app->setState(this);
                 break;
+            case '4':
+                app->setState(new GetPipelineState(this, [&](App *app, const string& code) {
+                    app->getData()->pipelineDegradation(code);
+                    PressEnterToContinue(1);
+                    app->setState(this);
+                }));
+                break;
             case 'q':
                 app->setState(new MainMenuState());
                 break;
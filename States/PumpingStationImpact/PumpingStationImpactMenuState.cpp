@@ -10,7 +10,8 @@ void PumpingStationImpactMenuState::display() const {
     cout << "\033[0m";
     cout << "   1. Not Essential             " << endl;
     cout << "   2. Specific Pumping Station  " << endl;
-    cout << "   3. All Pumping Stations      \n" << endl;
+    cout << "   3. All Pumping Stations      " << endl;
+    cout << "   4. Single Points of Failure  \n" << endl;
 
     cout << "   q. Main Menu              " << endl;
     cout << "\033[32m";
@@ -42,6 +43,11 @@ void PumpingStationImpactMenuState::handleInput(App* app) {
                 PressEnterToContinue();
                 app->setState(this);
                 break;
+            case '4':
+                app->getData()->singlePointsOfFailure();
+                PressEnterToContinue();
+                app->setState(this);
+                break;
             case 'q':
                 app->setState(new MainMenuState());
                 break;
@@ -24,7 +24,7 @@ public:
     * @brief Displays the Pumping Station Impact Menu options.
     *
     * @details This method prints the Pumping Station Impact Menu options to the console, allowing users to choose from different
-    * functionalities. Users input a single character corresponding to their desired option (1-3 for sections, 'q' to exit).
+    * functionalities. Users input a single character corresponding to their desired option (1-4 for sections, 'q' to exit).
     * The method provides a visual representation of the Find Max Water Flow Menu and prompts the user to enter their choice.
     */
     void display() const override;
@@ -0,0 +1,53 @@
+#include "States/MainMenuState.h"
+#include "SolverMenuState.h"
+#include <iomanip>
+#include "MaxFlowSolver.h"
+
+SolverMenuState::SolverMenuState() = default;
+
+void SolverMenuState::display() const {
+    const MaxFlowSolver *current = App::getInstance()->getMaxFlowSolver();
+    const vector<unique_ptr<MaxFlowSolver>> &solvers = MaxFlowSolverRegistry::getInstance()->getSolvers();
+
+    cout << "\033[32m";
+    cout << "===== MAX FLOW SOLVER =====" << endl;
+    cout << "\033[0m";
+    for(size_t i = 0; i < solvers.size(); i++) {
+        cout << "   " << i + 1 << ". " << setw(15) << left << solvers[i]->getName();
+        if(solvers[i].get() == current) cout << "(current)";
+        cout << endl;
+    }
+    cout << endl;
+
+    cout << "   q. Main Menu              " << endl;
+    cout << "\033[32m";
+    cout << "---------------------------" << endl;
+    cout << "\033[0m";
+    cout << "Enter your choice: ";
+}
+
+void SolverMenuState::handleInput(App* app) {
+    const vector<unique_ptr<MaxFlowSolver>> &solvers = MaxFlowSolverRegistry::getInstance()->getSolvers();
+    string choice;
+    cin >> choice;
+
+    if (choice.size() == 1) {
+        if (choice[0] == 'q') {
+            app->setState(new MainMenuState());
+        }
+        else if (choice[0] >= '1' && choice[0] < '1' + (int) solvers.size()) {
+            const MaxFlowSolver *solver = solvers[choice[0] - '1'].get();
+            app->setMaxFlowSolver(solver);
+            cout << "Max flow solver set to " << solver->getName() << "." << endl;
+            PressEnterToContinue();
+            app->setState(new MainMenuState());
+        }
+        else {
+            cout << "\033[31m" << "Invalid choice. Please try again." << "\033[0m"  << endl;
+        }
+    } else  {
+        cout << "\033[31m";
+        cout << "Invalid input. Please enter a single character." << endl;
+        cout << "\033[0m";
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_SOLVER_MENU_STATE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_SOLVER_MENU_STATE_H
+
+
+#include "States/State.h"
+
+/**
+* @brief Class representing the Max Flow Solver Menu state of the water supply analysis system.
+*/
+
+class SolverMenuState : public State {
+public:
+
+    /**
+    * @brief Default constructor for SolverMenuState.
+    *
+    * @details This constructor initializes an instance of the SolverMenuState class. It doesn't require any parameters,
+    * as it represents the Max Flow Solver Menu state of the application, allowing users to choose the algorithm used to
+    * compute the maximum flow.
+    */
+    SolverMenuState();
+
+    /**
+    * @brief Displays the Max Flow Solver Menu options.
+    *
+    * @details This method prints every solver of the MaxFlowSolverRegistry, marking the one currently selected.
+    * Users input a single character corresponding to their desired solver ('q' to go back to the Main Menu).
+    */
+    void display() const override;
+
+    /**
+    * @brief Handles user input for the Max Flow Solver Menu.
+    *
+    * @details This method prompts the user to input a single character representing the chosen solver. If the input is
+    * valid, the solver is selected for the application, which recomputes the maximum flow of the loaded network, if any.
+    * If the input is invalid, the method notifies the user and prompts them to try again. The 'q' option goes back
+    * to the Main Menu.
+    *
+    * @param app A pointer to the application instance.
+    */
+    void handleInput(App* app) override;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_SOLVER_MENU_STATE_H
@@ -10,7 +10,8 @@ void GetCityState::display() const {
 
 void GetCityState::handleInput(App* app) {
     string cityCode;
-    std::cin.ignore();
+    // Skip the end of the line of the previous choice, unless a previous state already read the whole line
+    if (std::cin.peek() == '\n') std::cin.ignore();
     std::getline(std::cin, cityCode);
 
     bool cityExists = app->getData()->deliverySiteExists(cityCode);
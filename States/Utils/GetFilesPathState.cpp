@@ -6,7 +6,8 @@ GetFilesPathState::GetFilesPathState(State* backState, function<void(App*)> next
         : backState(backState), nextStateCallback(std::move(nextStateCallback)) {}
 
 void GetFilesPathState::display() const {
-    cout << "Insert path to the files (Ex: \"./dataset/Project1DataSetSmall\"): ";
+    cout << "Insert path to the files or to a " << NetworkSnapshot::EXTENSION << " snapshot ";
+    cout << "(Ex: \"./dataset/Project1DataSetSmall\"): ";
 }
 
 void GetFilesPathState::handleInput(App* app) {
@@ -24,11 +25,13 @@ void GetFilesPathState::handleInput(App* app) {
             dir_path = filesystem::path(path);
         }
 
-        if (filesystem::exists(dir_path) && filesystem::is_directory(dir_path)) {
+        bool isSnapshot = filesystem::is_regular_file(dir_path) && dir_path.extension() == NetworkSnapshot::EXTENSION;
+
+        if (filesystem::exists(dir_path) && (filesystem::is_directory(dir_path) || isSnapshot)) {
             app->setData(dir_path);
             nextStateCallback(app);
         } else {
-            throw invalid_argument("Invalid path. Please enter a valid directory path.");
+            throw invalid_argument("Invalid path. Please enter a valid directory path or snapshot file.");
         }
     } catch (const DataLoadError& e) {
 
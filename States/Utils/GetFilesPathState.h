@@ -42,7 +42,8 @@ public:
     * @brief Handles user input for obtaining the path of the network csv files.
     *
     * @details This method reads a line of input from the console, representing the desired path of the network csv files for a specific operation.
-    * The method validates the entered input, ensuring it is a valid path.
+    * The method validates the entered input, ensuring it is a valid directory path or the path of a .wsnet network
+    * snapshot.
     * If the input is valid, the callback function is invoked with the captured number of top elements, and the application transitions to the next
     * state accordingly. If the input is invalid, the user is prompted with an error message, and the state transitions to a "Try Again" state,
     * allowing the user to make another attempt.
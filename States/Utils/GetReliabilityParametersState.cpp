@@ -0,0 +1,34 @@
+#include <sstream>
+#include "GetReliabilityParametersState.h"
+#include "TryAgainState.h"
+
+GetReliabilityParametersState::GetReliabilityParametersState(State* backState,
+                                                             function<void(App*, uint64_t, double, double, double)> nextStateCallback)
+        : backState(backState), nextStateCallback(std::move(nextStateCallback)) {}
+
+void GetReliabilityParametersState::display() const {
+    cout << "Insert samples and failure probabilities of reservoirs, stations and pipelines (Ex: 100000 0.01 0.02 0.005): ";
+}
+
+void GetReliabilityParametersState::handleInput(App* app) {
+    string line;
+    std::cin.ignore();
+    std::getline(std::cin, line);
+
+    istringstream input(line);
+    long long samples;
+    double pReservoir, pStation, pPipeline;
+    string extra;
+
+    bool valid = input >> samples >> pReservoir >> pStation >> pPipeline && !(input >> extra) && samples > 0;
+    for (double p : {pReservoir, pStation, pPipeline}) valid = valid && p >= 0 && p <= 1;
+
+    if (valid) {
+        nextStateCallback(app, (uint64_t) samples, pReservoir, pStation, pPipeline);
+    } else {
+        cout << "\033[31m";
+        cout << "Invalid parameters." << endl;
+        cout << "\033[0m";
+        app->setState(new TryAgainState(backState, this));
+    }
+}
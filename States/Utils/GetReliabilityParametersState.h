@@ -0,0 +1,54 @@
+#ifndef WATER_SUPPLY_ANALYSIS_SYSTEM_GET_RELIABILITY_PARAMETERS_STATE_H
+#define WATER_SUPPLY_ANALYSIS_SYSTEM_GET_RELIABILITY_PARAMETERS_STATE_H
+
+
+#include <cstdint>
+#include <utility>
+#include "States/State.h"
+
+/**
+* @brief Class that represents a state for obtaining the parameters of a reliability simulation.
+*/
+
+class GetReliabilityParametersState : public State {
+private:
+    State* backState;
+    function<void(App*, uint64_t, double, double, double)> nextStateCallback;
+public:
+
+    /**
+    * @brief Constructs an instance of GetReliabilityParametersState with specified back state and callback function.
+    *
+    * @details This constructor initializes an instance of the GetReliabilityParametersState class with the given back
+    * state and a callback function for transitioning to the next state. The back state represents the state to which the
+    * application should return when the user chooses to go back from the current state. The callback function is invoked
+    * with the number of samples and the failure probabilities of reservoirs, pumping stations and pipelines.
+    *
+    * @param backState A pointer to the state to which the application should return when the user chooses to go back.
+    * @param nextStateCallback A function defining the action to be performed with the captured parameters.
+    */
+    GetReliabilityParametersState(State* backState, function<void(App*, uint64_t, double, double, double)> nextStateCallback);
+
+    /**
+    * @brief Displays a prompt for inserting the parameters of a reliability simulation.
+    *
+    * @details This method prints a prompt to the console, asking the user to insert the number of samples followed by the
+    * failure probabilities of reservoirs, pumping stations and pipelines, in a single line.
+    */
+    void display() const override;
+
+    /**
+    * @brief Handles user input for obtaining the parameters of a reliability simulation.
+    *
+    * @details This method reads a line of input from the console and validates that it holds a positive number of
+    * samples and three probabilities between 0 and 1. If the parameters are valid, the callback function is invoked with
+    * them. Otherwise, the user is prompted with an error message, and the state transitions to a "Try Again" state,
+    * allowing the user to make another attempt.
+    *
+    * @param app A pointer to the application instance.
+    */
+    void handleInput(App* app) override;
+};
+
+
+#endif //WATER_SUPPLY_ANALYSIS_SYSTEM_GET_RELIABILITY_PARAMETERS_STATE_H
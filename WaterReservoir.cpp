@@ -1,7 +1,7 @@
 #include "WaterReservoir.h"
 
-WaterReservoir::WaterReservoir(string name, string municipality, double id, string code, double maxDelivery)
-    : name(std::move(name)), municipality(std::move(municipality)), id(id), code(std::move(code)), maxDelivery(maxDelivery) {}
+WaterReservoir::WaterReservoir(string name, string municipality, double id, string code, uint32_t vertexId, double maxDelivery)
+    : name(std::move(name)), municipality(std::move(municipality)), id(id), code(std::move(code)), vertexId(vertexId), maxDelivery(maxDelivery) {}
 
 double WaterReservoir::getMaxDelivery() {
     return this->maxDelivery;
@@ -9,4 +9,16 @@ double WaterReservoir::getMaxDelivery() {
 
 string WaterReservoir::getName() {
     return this->name;
-}
\ No newline at end of file
+}
+
+string WaterReservoir::getMunicipality() {
+    return this->municipality;
+}
+
+double WaterReservoir::getId() const {
+    return this->id;
+}
+
+uint32_t WaterReservoir::getVertexId() const {
+    return this->vertexId;
+}
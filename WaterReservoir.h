@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <cstdint>
 #include <utility>
 using namespace std;
 
@@ -16,6 +17,7 @@ private :
     string municipality;
     double id;
     string code;
+    uint32_t vertexId;
     double maxDelivery;
 
 public:
@@ -30,9 +32,10 @@ public:
     * @param municipality The name of the municipality.
     * @param id The id of the water reservoir.
     * @param code The unique code assigned to the water reservoir.
+    * @param vertexId The id of the vertex representing the water reservoir in the network graph.
     * @param maxDelivery The maximum delivery of water reservoir in m³/sec.
     */
-    WaterReservoir(string name, string municipality, double id, string code, double maxDelivery = 0);
+    WaterReservoir(string name, string municipality, double id, string code, uint32_t vertexId, double maxDelivery = 0);
 
     /**
      * @brief Get the maximum delivery capacity of the water reservoir.
@@ -47,6 +50,27 @@ public:
      * @return The name of the water reservoir.
      */
     string getName();
+
+    /**
+     * @brief Get the municipality of the water reservoir.
+     *
+     * @return The municipality of the water reservoir.
+     */
+    string getMunicipality();
+
+    /**
+     * @brief Get the id of the water reservoir.
+     *
+     * @return The id of the water reservoir.
+     */
+    [[nodiscard]] double getId() const;
+
+    /**
+     * @brief Get the id of the vertex representing the water reservoir in the network graph.
+     *
+     * @return The vertex id of the water reservoir.
+     */
+    [[nodiscard]] uint32_t getVertexId() const;
 };
 
 #endif //WATER_SUPPLY_ANALYSIS_SYSTEM_WATER_RESERVOIR_H
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include "NetworkGenerator.h"
+
+using namespace std;
+
+static const char *USAGE =
+        " <output dir> [--reservoirs <n>] [--stations <n>] [--cities <n>] [--degree <d>]\n"
+        "    [--distribution random|regular|powerlaw] [--alpha <a>] [--reservoir-links <n>] [--city-links <n>]\n"
+        "    [--capacity <min>:<max>] [--delivery <min>:<max>] [--demand <min>:<max>] [--bidirectional <ratio>]\n"
+        "    [--shards <n>] [--seed <n>]";
+
+// Parses a whole non-negative integer, throwing invalid_argument otherwise
+static uint64_t parseInteger(const string &value) {
+    if(value.empty() || value.size() > 19 || value.find_first_not_of("0123456789") != string::npos) {
+        throw invalid_argument("Invalid number: " + value);
+    }
+    return stoull(value);
+}
+
+static uint32_t parseCount(const string &value) {
+    uint64_t count = parseInteger(value);
+    if(count > UINT32_MAX / 2) throw invalid_argument("Number too large: " + value);
+    return (uint32_t) count;
+}
+
+static double parseReal(const string &value) {
+    size_t end = 0;
+    double result;
+    try {
+        result = stod(value, &end);
+    }
+    catch(const exception &) {
+        end = 0;
+    }
+    if(value.empty() || end != value.size()) throw invalid_argument("Invalid number: " + value);
+    return result;
+}
+
+// Parses "<min>:<max>", or a single value for both
+static ValueRange parseRange(const string &value) {
+    size_t colon = value.find(':');
+    if(colon == string::npos) {
+        uint64_t v = parseInteger(value);
+        return {v, v};
+    }
+    return {parseInteger(value.substr(0, colon)), parseInteger(value.substr(colon + 1))};
+}
+
+int main(int argc, char *argv[])
+{
+    GeneratorConfig config;
+    string outputDir;
+
+    // Options are given as "--<name> <value>" or "--<name>=<value>"
+    try {
+        for(int i = 1; i < argc; i++) {
+            string arg = argv[i];
+
+            if(arg.rfind("--", 0) != 0) {
+                if(!outputDir.empty()) throw invalid_argument("Unexpected argument: " + arg);
+                outputDir = arg;
+                continue;
+            }
+
+            string name = arg;
+            string value;
+            size_t equals = arg.find('=');
+            if(equals != string::npos) {
+                name = arg.substr(0, equals);
+                value = arg.substr(equals + 1);
+            }
+            else if(i + 1 < argc) {
+                value = argv[++i];
+            }
+            else {
+                throw invalid_argument("Missing value of " + arg);
+            }
+
+            if(name == "--reservoirs") config.reservoirs = parseCount(value);
+            else if(name == "--stations") config.stations = parseCount(value);
+            else if(name == "--cities") config.cities = parseCount(value);
+            else if(name == "--degree") config.degree = parseReal(value);
+            else if(name == "--alpha") config.alpha = parseReal(value);
+            else if(name == "--reservoir-links") config.reservoirLinks = parseCount(value);
+            else if(name == "--city-links") config.cityLinks = parseCount(value);
+            else if(name == "--capacity") config.capacity = parseRange(value);
+            else if(name == "--delivery") config.delivery = parseRange(value);
+            else if(name == "--demand") config.demand = parseRange(value);
+            else if(name == "--bidirectional") config.bidirectionalRatio = parseReal(value);
+            else if(name == "--shards") config.shards = parseCount(value);
+            else if(name == "--seed") config.seed = parseInteger(value);
+            else if(name == "--distribution") {
+                if(value == "random") config.distribution = DegreeDistribution::Random;
+                else if(value == "regular") config.distribution = DegreeDistribution::Regular;
+                else if(value == "powerlaw") config.distribution = DegreeDistribution::PowerLaw;
+                else throw invalid_argument("Unknown degree distribution: " + value);
+            }
+            else throw invalid_argument("Unknown argument: " + arg);
+        }
+        if(outputDir.empty()) throw invalid_argument("Missing output directory.");
+    }
+    catch(const exception &e) {
+        cerr << e.what() << endl;
+        cerr << "Usage: " << argv[0] << USAGE << endl;
+        return 1;
+    }
+
+    try {
+        auto start = chrono::steady_clock::now();
+        NetworkGenerator generator(config);
+        GeneratorStats stats = generator.generate(outputDir);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        cout << "Generated " << outputDir << ": " << config.reservoirs << " reservoirs, " << config.stations
+             << " stations, " << config.cities << " cities, " << stats.pipes << " pipes" << endl;
+        cout << stats.files << " files, " << fixed << setprecision(1) << (double) stats.bytes / (1 << 20) << " MB in "
+             << setprecision(2) << elapsed.count() << " s" << endl;
+    }
+    catch(const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
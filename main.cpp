@@ -1,12 +1,50 @@
 #include "App.h"
 #include "Data.h"
+#include "MaxFlowSolver.h"
 
 using namespace std;
 
-int main()
+int main(int argc, char *argv[])
 {
     App* app = App::getInstance();
 
+    // Select the max-flow solver given with "--solver <name>" or "--solver=<name>", and the number of threads of the
+    // failure sweeps given with "--threads <n>" or "--threads=<n>"
+    for(int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        string name;
+        string threads;
+
+        if(arg == "--solver" && i + 1 < argc) name = argv[++i];
+        else if(arg.rfind("--solver=", 0) == 0) name = arg.substr(9);
+        else if(arg == "--threads" && i + 1 < argc) threads = argv[++i];
+        else if(arg.rfind("--threads=", 0) == 0) threads = arg.substr(10);
+        else {
+            cerr << "Unknown argument: " << arg << endl;
+            cerr << "Usage: " << argv[0] << " [--solver <name>] [--threads <n>]" << endl;
+            return 1;
+        }
+
+        if(!threads.empty()) {
+            if(threads.find_first_not_of("0123456789") != string::npos || threads.size() > 4) {
+                cerr << "Invalid number of threads: " << threads << endl;
+                return 1;
+            }
+            app->setNumThreads(stoul(threads));
+            continue;
+        }
+
+        const MaxFlowSolver *solver = MaxFlowSolverRegistry::getInstance()->findSolver(name);
+        if(solver == nullptr) {
+            cerr << "Unknown max-flow solver: " << name << endl;
+            cerr << "Available solvers:";
+            for(const auto &s : MaxFlowSolverRegistry::getInstance()->getSolvers()) cerr << " " << s->getName();
+            cerr << endl;
+            return 1;
+        }
+        app->setMaxFlowSolver(solver);
+    }
+
     // Display the main menu
     while(app->getState() != nullptr) {
         app->display();
@@ -17,4 +55,4 @@ int main()
     delete app;
 
     return 0;
-}
\ No newline at end of file
+}